@@ -1,32 +1,85 @@
 #ifndef BOT_HPP_
 #define BOT_HPP_
 
+#include <boost/asio.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
 #include "game.hpp"
 #include "network_server.hpp"
-#include "nlohmann/json_fwd.hpp"
+#include "nlohmann/json.hpp"
 #include "runebound_fwd.hpp"
 
 namespace runebound::bot {
 
-struct Bot {
+// Plays the turns of bot characters. Every action is scheduled on a timer
+// bound to the strand of the room, so other games keep running while the
+// bot "thinks" and its actions never overlap with the players' ones.
+// The bot keeps itself alive through the pending timer and stops when the
+// active character is not a bot anymore.
+struct Bot : std::enable_shared_from_this<Bot> {
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_THINK_TIME{500};
+
 private:
+    enum class Step { THROW_DICE, MAKE_MOVE, CHECK_CHARACTERISTIC };
+
     std::shared_ptr<character::Character> m_bot;
+    std::shared_ptr<GameRoom> m_room;
     game::Game *m_game;
-    Connection *m_connection;
+    boost::asio::steady_timer m_timer;
+    std::chrono::milliseconds m_think_time;
+    Step m_step = Step::THROW_DICE;
 
-    void start_characteristic_check() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        m_game->check_characteristic(
-            m_bot, *(m_bot->get_cards(AdventureType::MEETING).begin()),
-            cards::OptionMeeting::FIRST
-        );
-        m_connection->send_game_for_all();
+    void schedule(Step step) {
+        m_step = step;
+        m_timer.expires_after(m_think_time);
+        m_timer.async_wait([self = shared_from_this()](
+                               boost::system::error_code ec
+                           ) {
+            if (!ec) {
+                self->run_step();
+            }
+        });
+    }
+
+    void run_step() {
+        try {
+            switch (m_step) {
+                case Step::THROW_DICE:
+                    throw_dice();
+                    break;
+                case Step::MAKE_MOVE:
+                    make_move();
+                    break;
+                case Step::CHECK_CHARACTERISTIC:
+                    check_characteristic();
+                    break;
+            }
+        } catch (std::exception &e) {
+            std::cerr << "Bot stopped: " << e.what() << std::endl;
+        }
+    }
+
+    // Plays the action like a player would, so it is journaled too.
+    void play(nlohmann::json action) {
+        m_room->play(m_bot, action);
+        Connection::send_game_for_all(*m_room);
+    }
+
+    void check_characteristic() {
+        nlohmann::json action;
+        action["action type"] = "adventure";
+        action["adventure command"] = "check_characteristic";
+        action["card"] = *(m_bot->get_cards(AdventureType::MEETING).begin());
+        action["option"] = cards::OptionMeeting::FIRST;
+        play(std::move(action));
+        end_turn();
     }
 
     void throw_dice() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
         if (m_bot->get_action_points() == 0) {
-            m_game->start_next_character_turn(m_bot);
+            end_turn();
             return;
         }
         if (m_bot->get_action_points() >= 2 &&
@@ -35,33 +88,52 @@ private:
                     .get_side_token() == Side::FRONT &&
             m_game->get_map().get_cell_map(m_bot->get_position()).get_token() ==
                 AdventureType::MEETING) {
-            m_game->take_token(m_bot);
-            start_characteristic_check();
-            m_connection->send_game_for_all();
-            m_game->start_next_character_turn(m_bot);
+            play({{"action type", "take token"}});
+            schedule(Step::CHECK_CHARACTERISTIC);
             return;
         }
-        m_game->throw_movement_dice(m_bot);
-        m_connection->send_game_for_all();
-        make_move();
+        play({{"action type", "throw move dice"}});
+        schedule(Step::MAKE_MOVE);
     }
 
     void make_move() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
         auto possible_moves = m_game->get_possible_moves();
-        m_game->make_move(
-            m_bot, possible_moves[runebound::rng() % possible_moves.size()]
-        );
-        m_connection->send_game_for_all();
-        throw_dice();
+        // The dice may reach no free cell.
+        if (possible_moves.empty()) {
+            end_turn();
+            return;
+        }
+        auto move =
+            possible_moves[m_game->get_random()() % possible_moves.size()];
+        play({{"action type", "make move"}, {"x", move.x}, {"y", move.y}});
+        schedule(Step::THROW_DICE);
+    }
+
+    void end_turn() {
+        play({{"action type", "pass"}});
+        auto next = m_game->get_active_character();
+        if (next->get_state_in_game() ==
+            character::StateCharacterInGame::BOT) {
+            m_bot = std::move(next);
+            schedule(Step::THROW_DICE);
+        }
     }
 
 public:
-    Bot(game::Game *game, Connection *connection)
-        : m_game(game), m_connection(connection) {
+    explicit Bot(
+        std::shared_ptr<GameRoom> room,
+        std::chrono::milliseconds think_time = DEFAULT_THINK_TIME
+    )
+        : m_room(std::move(room)),
+          m_game(&m_room->game),
+          m_timer(m_room->strand),
+          m_think_time(think_time) {
         m_bot = m_game->get_active_character();
-        throw_dice();
+    }
+
+    void start() {
+        schedule(Step::THROW_DICE);
     }
 };
 }  // namespace runebound::bot
-#endif  // BOT_HPP_
\ No newline at end of file
+#endif  // BOT_HPP_
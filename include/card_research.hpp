@@ -80,9 +80,12 @@ public:
         return m_outcomes[index].m_knowledge_token;
     }
 
+    // Checks that the necessary terrains of the outcome can be given
+    // distinct dice of the result. If there are fewer dice than terrains,
+    // only the first terrains are checked.
     [[nodiscard]] bool check_outcome(
         int index,
-        std::vector<::runebound::dice::HandDice> &result_dice
+        const std::vector<::runebound::dice::HandDice> &result_dice
     ) const;
 
     [[nodiscard]] std::string get_required_territory() const {
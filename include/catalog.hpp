@@ -0,0 +1,87 @@
+#ifndef CATALOG_HPP_
+#define CATALOG_HPP_
+
+#include <memory>
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <vector>
+#include "card_fight.hpp"
+#include "card_meeting.hpp"
+#include "card_research.hpp"
+#include "product.hpp"
+#include "runebound_fwd.hpp"
+
+namespace runebound::game {
+
+struct Catalog;
+
+void to_json(nlohmann::json &json, const Catalog &catalog);
+void from_json(const nlohmann::json &json, Catalog &catalog, map::Map &map);
+
+// Cards and products of the game. A catalog never changes after it is
+// loaded, so all games share one through a pointer to const and refer to
+// its cards and products by index.
+struct Catalog {
+private:
+    std::vector<cards::CardResearch> m_cards_research;
+    std::vector<cards::CardFight> m_cards_fight;
+    std::vector<cards::CardMeeting> m_cards_meeting;
+    std::vector<trade::Product> m_products;
+
+public:
+    // Reads the files of the folder in the order of their names.
+    static std::shared_ptr<const Catalog>
+    load(const std::string &folder, map::Map &map);
+
+    // The catalog of data/json, read on the first call.
+    static std::shared_ptr<const Catalog> get_standard();
+
+    [[nodiscard]] const cards::CardResearch &get_card_research(
+        unsigned int card
+    ) const {
+        return m_cards_research[card];
+    }
+
+    [[nodiscard]] const cards::CardFight &get_card_fight(unsigned int card
+    ) const {
+        return m_cards_fight[card];
+    }
+
+    [[nodiscard]] const cards::CardMeeting &get_card_meeting(unsigned int card
+    ) const {
+        return m_cards_meeting[card];
+    }
+
+    [[nodiscard]] const trade::Product &get_product(unsigned int product
+    ) const {
+        return m_products[product];
+    }
+
+    [[nodiscard]] const std::vector<cards::CardMeeting> &get_cards_meeting(
+    ) const {
+        return m_cards_meeting;
+    }
+
+    [[nodiscard]] const std::vector<trade::Product> &get_products() const {
+        return m_products;
+    }
+
+    [[nodiscard]] std::size_t get_count_products() const {
+        return m_products.size();
+    }
+
+    [[nodiscard]] std::size_t get_count_cards_research() const {
+        return m_cards_research.size();
+    }
+
+    [[nodiscard]] std::size_t get_count_cards_fight() const {
+        return m_cards_fight.size();
+    }
+
+    friend void to_json(nlohmann::json &json, const Catalog &catalog);
+    friend void
+    from_json(const nlohmann::json &json, Catalog &catalog, map::Map &map);
+};
+}  // namespace runebound::game
+
+#endif  // CATALOG_HPP_
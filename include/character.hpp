@@ -347,8 +347,12 @@ public:
         return m_health;
     }
 
-    [[nodiscard]] std::vector<::runebound::fight::FightToken> get_fight_token(
-    ) const {
+    [[nodiscard]] int get_max_health() const {
+        return m_max_health;
+    }
+
+    [[nodiscard]] const std::vector<::runebound::fight::FightToken> &
+    get_fight_token() const {
         return m_fight_tokens;
     }
 
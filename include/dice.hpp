@@ -1,12 +1,18 @@
 #ifndef DICE_HPP_
 #define DICE_HPP_
 
+#include <array>
+#include <cstdint>
+#include <span>
 #include "map_cell.hpp"
 #include "runebound_fwd.hpp"
 
 namespace runebound {
 namespace dice {
 
+const int COUNT_FACES = 6;
+const int COUNT_TERRAINS = 6;
+
 enum class HandDice {
     JOKER,
     PLAIN,
@@ -16,12 +22,47 @@ enum class HandDice {
     HILLS_PLAIN
 };
 
-HandDice throw_dice();
-std::vector<HandDice> get_combination_of_dice(unsigned int count_throws);
-bool check_hand_dice(
+// Bit t is set if a die lets the character enter a cell of TypeCell t.
+using TerrainMask = std::uint8_t;
+
+constexpr TerrainMask get_terrain_bit(::runebound::map::TypeCell type) {
+    return static_cast<TerrainMask>(1 << static_cast<int>(type));
+}
+
+namespace detail {
+using ::runebound::map::TypeCell;
+
+// Towns can be entered with any face, the joker enters everything.
+inline constexpr std::array<TerrainMask, COUNT_FACES> TERRAIN_MASKS{
+    0b111111,
+    get_terrain_bit(TypeCell::PLAIN) | get_terrain_bit(TypeCell::TOWN),
+    get_terrain_bit(TypeCell::PLAIN) | get_terrain_bit(TypeCell::FOREST) |
+        get_terrain_bit(TypeCell::TOWN),
+    get_terrain_bit(TypeCell::FOREST) | get_terrain_bit(TypeCell::HILLS) |
+        get_terrain_bit(TypeCell::TOWN),
+    get_terrain_bit(TypeCell::MOUNTAINS) | get_terrain_bit(TypeCell::WATER) |
+        get_terrain_bit(TypeCell::TOWN),
+    get_terrain_bit(TypeCell::HILLS) | get_terrain_bit(TypeCell::PLAIN) |
+        get_terrain_bit(TypeCell::TOWN)};
+}  // namespace detail
+
+constexpr TerrainMask get_terrain_mask(HandDice dice) {
+    return detail::TERRAIN_MASKS[static_cast<int>(dice)];
+}
+
+constexpr bool check_hand_dice(
     ::runebound::map::TypeCell type,
     ::runebound::dice::HandDice dice
-);
+) {
+    return (get_terrain_mask(dice) & get_terrain_bit(type)) != 0;
+}
+
+HandDice throw_dice(Random &random);
+// Fills faces with independent throws, several faces from every draw of the
+// generator.
+void throw_dice(std::span<HandDice> faces, Random &random);
+std::vector<HandDice>
+get_combination_of_dice(unsigned int count_throws, Random &random);
 
 }  // namespace dice
 }  // namespace runebound
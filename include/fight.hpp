@@ -5,6 +5,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <span>
 #include <vector>
 #include "character.hpp"
 #include "fight_token.hpp"
@@ -183,7 +184,7 @@ public:
         return m_name;
     }
 
-    [[nodiscard]] std::vector<FightToken> get_fight_token() const {
+    [[nodiscard]] const std::vector<FightToken> &get_fight_token() const {
         return m_fight_tokens;
     }
 
@@ -234,7 +235,7 @@ private:
 
     bool check_combination_tokens(const std::vector<TokenHandCount> &tokens);
 
-    void shuffle_all_tokens();
+    void shuffle_all_tokens(Random &random);
 
     void make_doubling_private(
         Participant participant,
@@ -255,8 +256,11 @@ private:
         const std::vector<TokenHandCount> &tokens
     ) const;
 
-    HandFightTokens
-    toss_token(Participant participant, const TokenHandCount &token);
+    HandFightTokens toss_token(
+        Participant participant,
+        const TokenHandCount &token,
+        Random &random
+    );
 
     HandFightTokens
     reverse_token(Participant participant, const TokenHandCount &token);
@@ -264,8 +268,14 @@ private:
 public:
     Fight() = default;
 
+    // The buffers of the remaining tokens are allocated here once, so the
+    // rounds of the fight do not allocate.
     Fight(std::shared_ptr<character::Character> character, Enemy enemy)
         : m_character(std::move(character)), m_enemy(std::move(enemy)) {
+        m_character_remaining_tokens.reserve(
+            m_character->get_fight_token().size()
+        );
+        m_enemy_remaining_tokens.reserve(m_enemy.get_fight_token().size());
     }
 
     [[nodiscard]] Participant get_winner() const {
@@ -308,7 +318,8 @@ public:
         Participant participant,
         const TokenHandCount &token,
         TokenHandCount dexterity_token,
-        Participant dexterity_participant
+        Participant dexterity_participant,
+        Random &random
     );
 
     void make_doubling(
@@ -342,7 +353,17 @@ public:
         return m_enemy_remaining_tokens;
     }
 
-    void start_round();
+    // A view of the remaining tokens of the participant, valid until the
+    // next action of the fight.
+    [[nodiscard]] std::span<const TokenHandCount> get_remaining_tokens(
+        Participant participant
+    ) const {
+        return participant == Participant::CHARACTER
+                   ? m_character_remaining_tokens
+                   : m_enemy_remaining_tokens;
+    }
+
+    void start_round(Random &random);
 
     friend void to_json(nlohmann::json &json, const Fight &fight);
     friend void from_json(
@@ -0,0 +1,58 @@
+#ifndef FIGHT_ARENA_HPP_
+#define FIGHT_ARENA_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "character.hpp"
+#include "fight_two_player.hpp"
+#include "random.hpp"
+
+namespace runebound::fight {
+
+// A duel without a winner after MAX_DUEL_ROUNDS rounds is unfinished.
+const unsigned int MAX_DUEL_ROUNDS = 100;
+
+struct DuelResult {
+    bool finished = false;
+    ParticipantTwoPlayers winner = ParticipantTwoPlayers::CALLER;
+    unsigned int rounds = 0;
+};
+
+struct ArenaStatistics {
+    std::size_t duels = 0;
+    std::size_t caller_wins = 0;
+    std::size_t receiver_wins = 0;
+    std::size_t unfinished = 0;
+    // rounds[r] is the number of finished duels that took r rounds.
+    std::vector<std::size_t> rounds =
+        std::vector<std::size_t>(MAX_DUEL_ROUNDS + 1, 0);
+
+    void add(const DuelResult &result);
+    void add(const ArenaStatistics &statistics);
+};
+
+// Plays a duel between the characters outside of a game. Both play the
+// policy of fight_policy.hpp, as in runebound_sim. The characters start
+// with full health and end with the health they have left.
+DuelResult play_duel(
+    const std::shared_ptr<character::Character> &caller,
+    const std::shared_ptr<character::Character> &receiver,
+    Random &random
+);
+
+// Plays count_duels duels on count_threads threads. Duel i is played with
+// the generator seeded with seed + i, so the statistics do not depend on
+// the number of threads. Every thread starts with an equal range of the
+// duels and idle threads steal half of the range of a busy one.
+ArenaStatistics run_arena(
+    const character::Character &caller,
+    const character::Character &receiver,
+    std::size_t count_duels,
+    std::uint64_t seed,
+    unsigned int count_threads
+);
+
+}  // namespace runebound::fight
+
+#endif  // FIGHT_ARENA_HPP_
@@ -0,0 +1,85 @@
+#ifndef FIGHT_EVALUATOR_HPP_
+#define FIGHT_EVALUATOR_HPP_
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "fight.hpp"
+#include "fight_token.hpp"
+#include "runebound_fwd.hpp"
+
+namespace runebound::fight {
+
+// The 2^n sides of the n tokens of a side are enumerated, so a side may
+// have at most this many tokens.
+const std::size_t MAX_EVALUATED_TOKENS = 20;
+
+struct TooManyFightTokensException : std::runtime_error {
+    TooManyFightTokensException()
+        : std::runtime_error("Too many fight tokens to evaluate") {
+    }
+};
+
+struct FightForecast {
+    double win_probability = 0;
+    // Infinite if the fight can go on forever.
+    double expected_rounds = 0;
+};
+
+// Computes exactly how a fight ends if both sides deal all their damage
+// every round. A round is resolved from the tossed sides of the tokens:
+// every doubling doubles one of the largest damage tokens, shields absorb
+// the damage of the other side, and the side with more initiative (the
+// character on a tie) strikes first, so the other one does not strike if
+// it dies. Dexterity and hits are not played.
+//
+// All 2^n sides of the tokens are enumerated once, on construction, which
+// throws TooManyFightTokensException above MAX_EVALUATED_TOKENS tokens. The
+// forecasts are memoized by the pair of healths.
+struct FightEvaluator {
+public:
+    FightEvaluator(
+        const std::vector<FightToken> &character_tokens,
+        const std::vector<FightToken> &enemy_tokens
+    );
+
+    [[nodiscard]] FightForecast
+    evaluate(int character_health, int enemy_health);
+
+private:
+    struct RoundOutcome {
+        int damage_to_character = 0;
+        int damage_to_enemy = 0;
+        bool character_first = true;
+        double probability = 0;
+
+        [[nodiscard]] auto get_key() const {
+            return std::tie(
+                damage_to_character, damage_to_enemy, character_first
+            );
+        }
+    };
+
+    std::vector<RoundOutcome> m_outcomes;
+    // The probability that nobody is damaged in a round.
+    double m_draw_probability = 0;
+    int m_memo_width = 0;
+    int m_memo_height = 0;
+    std::vector<std::optional<FightForecast>> m_memo;
+
+    FightForecast evaluate_memoized(int character_health, int enemy_health);
+};
+
+// The forecast of the fight with the enemy that the character would start
+// now, taking the knowledge tokens spent on a boss into account. The
+// evaluators of recent matchups are kept per thread.
+[[nodiscard]] FightForecast evaluate_fight(
+    const ::runebound::character::Character &character,
+    const Enemy &enemy
+);
+
+}  // namespace runebound::fight
+
+#endif  // FIGHT_EVALUATOR_HPP_
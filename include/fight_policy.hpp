@@ -0,0 +1,93 @@
+#ifndef FIGHT_POLICY_HPP_
+#define FIGHT_POLICY_HPP_
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include "fight.hpp"
+#include "fight_two_player.hpp"
+
+namespace runebound::fight {
+
+inline bool is_damage(HandFightTokens hand) {
+    return hand == HandFightTokens::PHYSICAL_DAMAGE ||
+           hand == HandFightTokens::MAGICAL_DAMAGE ||
+           hand == HandFightTokens::ENEMY_DAMAGE;
+}
+
+// The side to move doubles its strongest damage token if it can, otherwise
+// plays all its damage tokens of the strongest kind, otherwise passes. The
+// first side (the character or the caller) passes with PassFirst, the other
+// with PassSecond. The played tokens are gathered in used, so a caller that
+// keeps it between moves does not allocate.
+template <
+    typename FightType,
+    void (FightType::*PassFirst)(),
+    void (FightType::*PassSecond)()>
+void make_policy_move(FightType &fight, std::vector<TokenHandCount> &used) {
+    auto participant = fight.get_turn();
+    auto tokens = fight.get_remaining_tokens(participant);
+    auto best_hand = HandFightTokens::NOTHING;
+    int best_damage = 0;
+    for (const auto &token : tokens) {
+        if (!is_damage(token.hand)) {
+            continue;
+        }
+        int damage = 0;
+        for (const auto &other : tokens) {
+            if (other.hand == token.hand) {
+                damage += other.count;
+            }
+        }
+        if (damage > best_damage) {
+            best_damage = damage;
+            best_hand = token.hand;
+        }
+    }
+    if (best_hand == HandFightTokens::NOTHING) {
+        if (static_cast<Participant>(participant) == Participant::CHARACTER) {
+            (fight.*PassFirst)();
+        } else {
+            (fight.*PassSecond)();
+        }
+        return;
+    }
+    auto doubling =
+        std::find_if(tokens.begin(), tokens.end(), [](const auto &token) {
+            return token.hand == HandFightTokens::DOUBLING;
+        });
+    if (doubling != tokens.end()) {
+        auto strongest = std::max_element(
+            tokens.begin(), tokens.end(),
+            [best_hand](const auto &lhs, const auto &rhs) {
+                return (lhs.hand == best_hand ? lhs.count : -1) <
+                       (rhs.hand == best_hand ? rhs.count : -1);
+            }
+        );
+        fight.make_doubling(participant, *doubling, *strongest);
+        return;
+    }
+    used.clear();
+    std::copy_if(
+        tokens.begin(), tokens.end(), std::back_inserter(used),
+        [best_hand](const auto &token) { return token.hand == best_hand; }
+    );
+    fight.make_damage(participant, used);
+}
+
+inline void make_policy_move(Fight &fight, std::vector<TokenHandCount> &used) {
+    make_policy_move<Fight, &Fight::pass_character, &Fight::pass_enemy>(
+        fight, used
+    );
+}
+
+inline void
+make_policy_move(FightTwoPlayer &fight, std::vector<TokenHandCount> &used) {
+    make_policy_move<
+        FightTwoPlayer, &FightTwoPlayer::pass_caller,
+        &FightTwoPlayer::pass_receiver>(fight, used);
+}
+
+}  // namespace runebound::fight
+
+#endif  // FIGHT_POLICY_HPP_
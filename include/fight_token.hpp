@@ -1,12 +1,14 @@
 #ifndef FIGHT_TOKEN_HPP_
 #define FIGHT_TOKEN_HPP_
 
+#include <cstdint>
+#include <stdexcept>
 #include "nlohmann/json.hpp"
 #include "runebound_fwd.hpp"
 
 namespace runebound::fight {
 
-enum class HandFightTokens {
+enum class HandFightTokens : std::uint8_t {
     PHYSICAL_DAMAGE,
     MAGICAL_DAMAGE,
     DEXTERITY,
@@ -20,14 +22,19 @@ enum class HandFightTokens {
 void to_json(nlohmann::json &json, const FightToken &fight_token);
 void from_json(const nlohmann::json &json, FightToken &fight_token);
 
+// A token packed into 32 bits: the hand, the initiative and the count of
+// each side take 12 bits. The members keep their names, so they are read
+// and written as before.
 struct FightToken {
 public:
-    HandFightTokens first = HandFightTokens::NOTHING;
-    bool first_lead = 0;
-    int first_count = 0;
-    HandFightTokens second = HandFightTokens::NOTHING;
-    bool second_lead = 0;
-    int second_count = 0;
+    static constexpr int MAX_COUNT = 127;
+
+    HandFightTokens first : 3 = HandFightTokens::NOTHING;
+    bool first_lead : 1 = false;
+    int first_count : 8 = 0;
+    HandFightTokens second : 3 = HandFightTokens::NOTHING;
+    bool second_lead : 1 = false;
+    int second_count : 8 = 0;
 
     FightToken() = default;
 
@@ -41,38 +48,56 @@ public:
     )
         : first(first_),
           first_lead(first_lead_),
-          first_count(first_count_),
+          first_count(check_count(first_count_)),
           second(second_),
           second_lead(second_lead_),
-          second_count(second_count_) {
+          second_count(check_count(second_count_)) {
+    }
+
+    // Equal tokens have equal codes, so the code identifies the token.
+    [[nodiscard]] std::uint32_t get_code() const {
+        return static_cast<std::uint32_t>(first) |
+               static_cast<std::uint32_t>(first_lead) << 3 |
+               static_cast<std::uint32_t>(first_count) << 4 |
+               static_cast<std::uint32_t>(second) << 12 |
+               static_cast<std::uint32_t>(second_lead) << 15 |
+               static_cast<std::uint32_t>(second_count) << 16;
     }
 
     bool operator==(const FightToken &token) const {
-        return first_lead == token.first_lead &&
-               second_lead == token.second_lead && first == token.first &&
-               second == token.second && first_count == token.first_count &&
-               second_count == token.second_count;
+        return get_code() == token.get_code();
     }
 
     friend void to_json(nlohmann::json &json, const FightToken &fight_token) {
-        json["first"] = fight_token.first;
-        json["first_lead"] = fight_token.first_lead;
-        json["first_count"] = fight_token.first_count;
-        json["second"] = fight_token.second;
-        json["second_lead"] = fight_token.second_lead;
-        json["second_count"] = fight_token.second_count;
+        json["first"] = HandFightTokens{fight_token.first};
+        json["first_lead"] = bool{fight_token.first_lead};
+        json["first_count"] = int{fight_token.first_count};
+        json["second"] = HandFightTokens{fight_token.second};
+        json["second_lead"] = bool{fight_token.second_lead};
+        json["second_count"] = int{fight_token.second_count};
     }
 
     friend void from_json(const nlohmann::json &json, FightToken &fight_token) {
-        fight_token.first = json["first"];
-        fight_token.second = json["second"];
-        fight_token.first_lead = json["first_lead"];
-        fight_token.second_lead = json["second_lead"];
-        fight_token.first_count = json["first_count"];
-        fight_token.second_count = json["second_count"];
+        fight_token.first = json["first"].get<HandFightTokens>();
+        fight_token.second = json["second"].get<HandFightTokens>();
+        fight_token.first_lead = json["first_lead"].get<bool>();
+        fight_token.second_lead = json["second_lead"].get<bool>();
+        fight_token.first_count = check_count(json["first_count"].get<int>());
+        fight_token.second_count =
+            check_count(json["second_count"].get<int>());
+    }
+
+private:
+    static int check_count(int count) {
+        if (count < 0 || count > MAX_COUNT) {
+            throw std::out_of_range("Fight token count out of range");
+        }
+        return count;
     }
 };
 
+static_assert(sizeof(FightToken) == sizeof(std::uint32_t));
+
 }  // namespace runebound::fight
 
 #endif  // FIGHT_TOKEN_HPP_
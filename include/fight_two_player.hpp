@@ -2,6 +2,7 @@
 #define FIGHT_TWO_PLAYER_HPP_
 
 #include <memory>
+#include <span>
 #include "character.hpp"
 #include "fight.hpp"
 #include "runebound_fwd.hpp"
@@ -64,6 +65,16 @@ public:
         return m_fight.get_enemy_remaining_tokens();
     }
 
+    // A view of the remaining tokens of the participant, valid until the
+    // next action of the fight.
+    [[nodiscard]] std::span<const TokenHandCount> get_remaining_tokens(
+        ParticipantTwoPlayers participant
+    ) const {
+        return m_fight.get_remaining_tokens(
+            static_cast<Participant>(participant)
+        );
+    }
+
     [[nodiscard]] ParticipantTwoPlayers get_turn() const {
         return static_cast<ParticipantTwoPlayers>(m_fight.get_turn());
     }
@@ -91,17 +102,18 @@ public:
         ParticipantTwoPlayers participant,
         const TokenHandCount &token,
         TokenHandCount dexterity_token,
-        ParticipantTwoPlayers dexterity_participant
+        ParticipantTwoPlayers dexterity_participant,
+        Random &random
     ) {
         m_fight.make_dexterity(
             static_cast<Participant>(participant), token, dexterity_token,
-            static_cast<Participant>(dexterity_participant)
+            static_cast<Participant>(dexterity_participant), random
         );
         m_receiver->set_health(m_fight.get_health_enemy());
     }
 
-    void start_round() {
-        m_fight.start_round();
+    void start_round(Random &random) {
+        m_fight.start_round(random);
     }
 
     [[nodiscard]] bool check_end_fight() const {
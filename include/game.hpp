@@ -1,6 +1,7 @@
 #ifndef GAME_HPP_
 #define GAME_HPP_
 
+#include <array>
 #include <map>
 #include <memory>
 #include <nlohmann/json_fwd.hpp>
@@ -9,11 +10,13 @@
 #include "card_fight.hpp"
 #include "card_meeting.hpp"
 #include "card_research.hpp"
+#include "catalog.hpp"
 #include "character.hpp"
 #include "fight.hpp"
 #include "fight_two_player.hpp"
 #include "map.hpp"
 #include "product.hpp"
+#include "random.hpp"
 #include "runebound_fwd.hpp"
 #include "skill_card.hpp"
 
@@ -120,6 +123,11 @@ struct NoFight : std::runtime_error {
     }
 };
 
+struct EmptyDeckException : std::runtime_error {
+    EmptyDeckException() : std::runtime_error("The deck is empty.") {
+    }
+};
+
 struct CellBusy : std::runtime_error {
     CellBusy() : std::runtime_error("Cell busy.") {
     }
@@ -131,9 +139,14 @@ struct NotSelectedCharacter : std::runtime_error {
     }
 };
 
+// Parts of the game its clients see. A snapshot of the game serializes
+// again only the parts whose versions changed since it was taken.
+enum class GamePart { MAP, TURN, CHARACTERS, DICE, SHOPS, FIGHT, COUNT };
+
 struct Game {
 private:
     friend struct GameClient;
+    friend struct GameClientSnapshot;
     bool m_game_over = false;
     ::runebound::map::Map m_map;
     std::vector<std::shared_ptr<::runebound::character::Character>>
@@ -147,16 +160,35 @@ private:
     unsigned int m_current_active_card_fight = 0;
     character::StandardCharacter m_winner = character::StandardCharacter::NONE;
     Point m_boss_position = {-1, -1};
+    Random m_random;
+
+    // The version of the map part is the version of the map itself.
+    std::array<unsigned long long, static_cast<std::size_t>(GamePart::COUNT)>
+        m_part_versions{};
+
+    // Possible moves of the active character. They are found again only
+    // when its position, its dice, the positions of the characters or the
+    // cells of the map change.
+    struct PossibleMovesCache {
+        bool valid = false;
+        Point position;
+        std::vector<dice::HandDice> dice;
+        std::vector<Point> occupied;
+        unsigned long long map_version = 0;
+        std::vector<bool> cells;
+        std::vector<Point> moves;
+    };
+
+    mutable PossibleMovesCache m_possible_moves;
+
+    void update_possible_moves() const;
     std::vector<dice::HandDice> m_last_dice_movement_result;
     std::vector<dice::HandDice> m_last_dice_relax_result;
     std::vector<dice::HandDice> m_last_dice_research_result;
     std::vector<std::size_t> m_last_possible_outcomes;
 
-    std::vector<cards::CardResearch> m_all_cards_research;
-    std::vector<cards::CardFight> m_all_cards_fight;
-    std::vector<cards::CardMeeting> m_all_cards_meeting;
+    std::shared_ptr<const Catalog> m_catalog = Catalog::get_standard();
     std::vector<cards::SkillCard> m_all_skill_cards;
-    std::vector<trade::Product> m_all_products;
 
     std::set<character::StandardCharacter> m_remaining_standard_characters = {
         character::StandardCharacter::LISSA,
@@ -186,18 +218,12 @@ private:
     }
 
     void generate_all_skill_cards();
-    void generate_all_cards_fight();
-    void generate_all_cards_research();
-    void generate_all_cards_meeting();
-    void generate_all_products();
+    void generate_decks();
     void generate_all_shops();
 
     void generate_all() {
-        generate_all_cards_research();
-        generate_all_cards_fight();
-        generate_all_cards_meeting();
+        generate_decks();
         generate_all_skill_cards();
-        generate_all_products();
         generate_all_shops();
     }
 
@@ -215,7 +241,7 @@ private:
 
     void add_product_to_shop(Point town) {
         auto product =
-            m_remaining_products[rng() % m_remaining_products.size()];
+            m_remaining_products[m_random() % m_remaining_products.size()];
         m_shops[town].insert(product);
         m_remaining_products.erase(std::find(
             m_remaining_products.begin(), m_remaining_products.end(), product
@@ -256,9 +282,31 @@ private:
     }
 
 public:
-    Game() {
+    Game() : Game(Random::make_seed()) {
+    }
+
+    explicit Game(std::uint64_t seed) : m_random(seed) {
         generate_all();
-    };
+    }
+
+    // Every method of the game marks the parts it may change. Whoever
+    // changes a part through a pointer the game handed out, such as the
+    // current fight or a character, marks it as well.
+    void mark_changed(GamePart part) {
+        ++m_part_versions[static_cast<std::size_t>(part)];
+    }
+
+    [[nodiscard]] unsigned long long get_part_version(GamePart part) const {
+        if (part == GamePart::MAP) {
+            return m_map.get_version();
+        }
+        return m_part_versions[static_cast<std::size_t>(part)];
+    }
+
+    // Everything random in the game comes from this generator.
+    [[nodiscard]] Random &get_random() {
+        return m_random;
+    }
 
     auto get_characters() {
         return m_characters;
@@ -300,6 +348,11 @@ public:
         return m_number_of_rounds;
     }
 
+    // {-1, -1} until the boss appears.
+    [[nodiscard]] Point get_boss_position() const {
+        return m_boss_position;
+    }
+
     [[nodiscard]] std::set<Point> get_towns() const {
         return m_map.get_towns();
     }
@@ -309,16 +362,16 @@ public:
     }
 
     [[nodiscard]] trade::Product get_product(unsigned int product) {
-        return m_all_products[product];
+        return m_catalog->get_product(product);
     }
 
     [[nodiscard]] cards::CardResearch get_card_research(unsigned int card
     ) const {
-        return m_all_cards_research[card];
+        return m_catalog->get_card_research(card);
     }
 
     [[nodiscard]] cards::CardMeeting get_card_meeting(unsigned int card) const {
-        return m_all_cards_meeting[card];
+        return m_catalog->get_card_meeting(card);
     }
 
     [[nodiscard]] std::vector<std::size_t> get_last_possible_outcomes() const {
@@ -326,7 +379,7 @@ public:
     }
 
     [[nodiscard]] cards::CardFight get_card_fight(unsigned int card) const {
-        return m_all_cards_fight[card];
+        return m_catalog->get_card_fight(card);
     }
 
     [[nodiscard]] std::vector<Point> get_territory_cells(
@@ -361,8 +414,12 @@ public:
     ) {
         check_turn(chr);
         check_sufficiency_action_points(1);
+        mark_changed(GamePart::DICE);
+        mark_changed(GamePart::CHARACTERS);
         m_last_dice_movement_result =
-            ::runebound::dice::get_combination_of_dice(chr->get_speed());
+            ::runebound::dice::get_combination_of_dice(
+                chr->get_speed(), m_random
+            );
         chr->update_action_points(-1);
         return m_last_dice_movement_result;
     }
@@ -371,8 +428,11 @@ public:
         const std::shared_ptr<character::Character> &chr
     ) {
         check_turn(chr);
+        mark_changed(GamePart::DICE);
         m_last_dice_research_result =
-            ::runebound::dice::get_combination_of_dice(chr->get_speed());
+            ::runebound::dice::get_combination_of_dice(
+                chr->get_speed(), m_random
+            );
         return m_last_dice_research_result;
     }
 
@@ -380,8 +440,9 @@ public:
         const std::shared_ptr<character::Character> &chr
     ) {
         check_turn(chr);
+        mark_changed(GamePart::DICE);
         m_last_dice_relax_result =
-            ::runebound::dice::get_combination_of_dice(5);
+            ::runebound::dice::get_combination_of_dice(5, m_random);
         return m_last_dice_relax_result;
     }
 
@@ -389,8 +450,11 @@ public:
         const std::shared_ptr<character::Character> &chr
     ) {
         check_turn(chr);
+        mark_changed(GamePart::DICE);
         m_last_dice_movement_result =
-            ::runebound::dice::get_combination_of_dice(chr->get_speed());
+            ::runebound::dice::get_combination_of_dice(
+                chr->get_speed(), m_random
+            );
         return m_last_dice_movement_result;
     }
 
@@ -410,6 +474,7 @@ public:
         if (!receiver->check_caller_to_fight()) {
             throw NotCalledToFight();
         }
+        mark_changed(GamePart::CHARACTERS);
         receiver->refuse_to_fight();
     }
 
@@ -455,6 +520,8 @@ public:
         std::string name,
         const std::vector<::runebound::fight::FightToken> &tokens
     ) {
+        mark_changed(GamePart::CHARACTERS);
+        mark_changed(GamePart::TURN);
         m_characters.emplace_back(
             std::make_shared<::runebound::character::Character>(
                 ::runebound::character::Character(
@@ -517,10 +584,11 @@ public:
         if (!chr->check_card(type, card)) {
             throw NoCardException();
         }
+        mark_changed(GamePart::CHARACTERS);
 
         if (type == AdventureType::RESEARCH) {
             auto required_cells = m_map.get_territory_cells(
-                m_all_cards_research[card].get_required_territory()
+                m_catalog->get_card_research(card).get_required_territory()
             );
             if (std::find(
                     required_cells.begin(), required_cells.end(),
@@ -566,7 +634,10 @@ public:
         unsigned int product
     );
 
-    [[nodiscard]] std::vector<Point> get_possible_moves() const;
+    [[nodiscard]] const std::vector<Point> &get_possible_moves() const;
+
+    // The cells of get_possible_moves as one bit per cell index.
+    [[nodiscard]] const std::vector<bool> &get_possible_moves_cells() const;
 
     void exit_game(const std::shared_ptr<character::Character> &chr);
     void exit_game_and_replace_with_bot(
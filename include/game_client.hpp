@@ -62,8 +62,8 @@ public:
           m_last_possible_outcomes(game.m_last_possible_outcomes),
           m_possible_moves(game.get_possible_moves()),
           m_shops(game.m_shops),
-          m_all_products(game.m_all_products),
-          m_all_cards_meeting(game.m_all_cards_meeting) {
+          m_all_products(game.m_catalog->get_products()),
+          m_all_cards_meeting(game.m_catalog->get_cards_meeting()) {
         auto set_remaining =
             std::move(game.get_remaining_standard_characters());
 
@@ -80,7 +80,7 @@ public:
 
         if (game.m_current_fight != nullptr) {
             m_reward_gold_for_fight =
-                game.m_all_cards_fight[game.m_current_active_card_fight]
+                game.m_catalog->get_card_fight(game.m_current_active_card_fight)
                     .get_gold_award();
         }
 
@@ -101,5 +101,44 @@ public:
     friend void from_json(const nlohmann::json &json, GameClient &game);
 };
 
+// Last GameClient state sent to a room. Each change is broadcast as a JSON
+// patch against the previous state; the version grows by one per patch, so
+// a client that misses a version asks for the whole state again. Only the
+// parts of the game whose versions changed are serialized and compared.
+struct GameClientSnapshot {
+private:
+    unsigned long long m_version = 0;
+    nlohmann::json m_state;
+    std::array<unsigned long long, static_cast<std::size_t>(GamePart::COUNT)>
+        m_part_versions{};
+
+    static void part_to_json(
+        nlohmann::json &json,
+        const Game &game,
+        GamePart part
+    );
+
+    // Patches the key of the state to the value. A null value removes the
+    // key, as the state has no m_fight_client out of a fight.
+    void update_key(
+        nlohmann::json &patch,
+        const std::string &key,
+        nlohmann::json value
+    );
+
+public:
+    // Stores the state of the game and returns the patch from the previous
+    // state. The version is not changed if nothing changed.
+    nlohmann::json update(const Game &game);
+
+    [[nodiscard]] unsigned long long get_version() const {
+        return m_version;
+    }
+
+    [[nodiscard]] const nlohmann::json &get_state() const {
+        return m_state;
+    }
+};
+
 }  // namespace runebound::game
 #endif  // GAME_CLIENT_HPP_
@@ -0,0 +1,62 @@
+#ifndef GAME_JOURNAL_HPP_
+#define GAME_JOURNAL_HPP_
+
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace runebound::network {
+
+// Append-only log of the actions of one game, one JSON line per action.
+// Every entry gets the next sequence number. The log is split into
+// segments named <game>.<first sequence>.journal, so the segments that a
+// snapshot already covers can be removed as a whole.
+class GameJournal {
+public:
+    GameJournal(
+        std::filesystem::path folder,
+        std::string game_name,
+        unsigned long long sequence = 0
+    );
+
+    // Writes the entry and flushes it to the operating system.
+    void append(nlohmann::json entry);
+
+    [[nodiscard]] unsigned long long get_sequence() const {
+        return m_sequence;
+    }
+
+    // Entries appended from now on go to a new segment.
+    void start_segment();
+
+    // Removes the segments whose entries all have sequence numbers up to
+    // the given one.
+    void remove_segments_up_to(unsigned long long sequence) const;
+
+    // Entries with sequence numbers greater than the given one, in order.
+    // A torn last line left by a crash is skipped.
+    static std::vector<nlohmann::json> read(
+        const std::filesystem::path &folder,
+        const std::string &game_name,
+        unsigned long long after_sequence
+    );
+
+private:
+    // Segments of the game sorted by their first sequence number.
+    static std::vector<std::pair<unsigned long long, std::filesystem::path>>
+    find_segments(
+        const std::filesystem::path &folder,
+        const std::string &game_name
+    );
+
+    std::filesystem::path m_folder;
+    std::string m_game_name;
+    unsigned long long m_sequence;
+    std::ofstream m_file;
+};
+}  // namespace runebound::network
+
+#endif  // GAME_JOURNAL_HPP_
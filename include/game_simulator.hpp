@@ -0,0 +1,64 @@
+#ifndef GAME_SIMULATOR_HPP_
+#define GAME_SIMULATOR_HPP_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include "character.hpp"
+
+namespace runebound::simulator {
+
+const unsigned int MAX_ROUNDS = 100;
+const unsigned int MAX_FIGHT_ROUNDS = 50;
+const std::array<std::pair<character::StandardCharacter, const char *>, 6>
+    CHARACTERS{
+        {{character::StandardCharacter::LISSA, "Lissa"},
+         {character::StandardCharacter::CORBIN, "Corbin"},
+         {character::StandardCharacter::ELDER_MOK, "Elder Mok"},
+         {character::StandardCharacter::LAUREL_FROM_BLOODWOOD,
+          "Laurel from Bloodwood"},
+         {character::StandardCharacter::LORD_HAWTHORNE, "Lord Hawthorne"},
+         {character::StandardCharacter::MASTER_THORN, "Master Thorn"}}};
+
+// A game is stalled when it lasts MAX_ROUNDS rounds or a fight has no
+// winner after MAX_FIGHT_ROUNDS rounds. A game fails when the engine
+// throws.
+struct Statistics {
+    std::size_t games = 0;
+    std::size_t no_winner = 0;
+    std::size_t stalled = 0;
+    std::size_t failed = 0;
+    std::size_t rounds = 0;
+    std::size_t boss_fights = 0;
+    std::array<std::size_t, CHARACTERS.size() + 1> played{};
+    std::array<std::size_t, CHARACTERS.size() + 1> wins{};
+    std::array<std::size_t, CHARACTERS.size() + 1> trophies{};
+    std::string first_error;
+
+    void add(const Statistics &other);
+};
+
+// Plays a whole game through the Game API and adds it to the statistics.
+// The game is created with the seed, and the policy has its own generator
+// made from the seed too, so a game is repeated with its seed. The
+// characters and their seats are drawn from the roster with the policy
+// generator, so no character always moves first or always sits out.
+//
+// Every character plays the same policy: relax when at most half healthy,
+// complete research cards in their territories with the outcome giving the
+// most knowledge, and take research tokens first, then any other token.
+// Once the boss is on the map, a character with the 7 knowledge tokens that
+// weaken it fully, or any character from round 25 when the boss marches on
+// Talamir, goes for the boss. Meetings pick the option with more knowledge.
+// Fights are played by doubling the strongest damage token if possible,
+// otherwise dealing all damage of the strongest kind.
+void play_game(
+    std::uint64_t seed,
+    std::size_t count_players,
+    Statistics &statistics
+);
+
+}  // namespace runebound::simulator
+
+#endif  // GAME_SIMULATOR_HPP_
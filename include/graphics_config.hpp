@@ -38,8 +38,6 @@ extern const std::map<::runebound::character::StandardCharacter, std::string>
 extern const std::map<std::string, std::string> CHARACTER_NAMES_WITH_DASH;
 extern const std::map<::runebound::fight::HandFightTokens, std::string>
     HAND_FIGHT_TOKENS_TO_STR;
-extern const std::map<std::pair<int, int>, std::pair<int, int>>
-    RIVER_DIRECTIONS;
 enum class HorizontalButtonTextureAlign { NONE, LEFT, CENTER, RIGHT };
 enum class VerticalButtonTextureAlign { NONE, TOP, CENTER, BOTTOM };
 }  // namespace runebound::graphics
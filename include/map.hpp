@@ -3,140 +3,139 @@
 
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <queue>
 #include <set>
+#include <string>
 #include <vector>
 #include "dice.hpp"
 #include "map_cell.hpp"
+#include "map_grid.hpp"
+#include "map_neighbours.hpp"
 #include "point.hpp"
 
 namespace runebound::map {
 
-const int STANDARD_SIZE = 15;
-
 void to_json(nlohmann::json &json, const Map &map);
 void from_json(const nlohmann::json &json, Map &map);
 
+// Parts of a map that do not change during a game. Copies of a map share
+// them.
+struct MapLayout {
+    std::set<std::pair<Point, Point>> rivers;
+    // Bit d of a cell is set if a river separates it from its neighbour in
+    // get_directions(cell)[d].
+    std::vector<std::uint8_t> river_directions;
+    std::set<Point> towns;
+    std::map<std::string, std::vector<Point>> territory_name;
+};
+
 struct Map {
 private:
     friend struct MapClient;
-    std::vector<std::vector<MapCell>> m_map;  // [row][column]
-    std::set<std::pair<Point, Point>> m_rivers;
-    std::set<Point> m_towns;
-    int m_size;
-    std::map<std::string, std::vector<Point>> m_territory_name;
-    const std::vector<Point> directions_odd_column{{-1, 0}, {0, 1},  {1, 1},
-                                                   {1, 0},  {1, -1}, {0, -1}};
-    const std::vector<Point> directions_even_column{{-1, 0}, {-1, 1}, {0, 1},
-                                                    {1, 0},  {0, -1}, {-1, -1}};
+    // Shared between copies of the map until one of them changes a cell.
+    std::shared_ptr<MapGrid> m_map;
+    std::shared_ptr<const MapLayout> m_layout;
+    int m_size = 0;
+    // Changes with every change of the cells. Maps with equal versions have
+    // equal cells.
+    unsigned long long m_version = 0;
+
+    static unsigned long long make_version();
+
+    // Checks the step from the cell with the index current to its neighbour
+    // next in the direction with a die of the terrain mask.
+    [[nodiscard]] bool check_step(
+        std::size_t current,
+        std::size_t next,
+        int direction,
+        ::runebound::dice::TerrainMask terrains
+    ) const;
+
+    [[nodiscard]] std::vector<std::uint8_t> index_rivers(
+        const std::set<std::pair<Point, Point>> &rivers
+    ) const;
+
+    [[nodiscard]] std::set<Point> find_towns() const;
+
+    // Returns the cells of this map, copying them first if they are shared
+    // with another map.
+    MapGrid &get_grid_for_change();
 
     [[nodiscard]] std::vector<Point> make_move(
         const Point &start,
         const Point &end,
-        const std::vector<::runebound::dice::HandDice> &dice_roll_results,
-        int count_dice
+        std::vector<::runebound::dice::HandDice> dice_roll_results,
+        std::vector<bool> *reachable
     ) const;
 
-    void find_towns() {
-        for (int row = 0; row < STANDARD_SIZE; ++row) {
-            for (int column = 0; column < STANDARD_SIZE; ++column) {
-                if (m_map[row][column].get_type_cell() == TypeCell::TOWN) {
-                    m_towns.insert(Point(row, column));
-                }
-            }
-        }
-    }
-
 public:
-    Map() {
-        nlohmann::json json;
-        std::ifstream in("data/json/map/map.json");
-        in >> json;
-        ::runebound::map::from_json(json, *this);
-    }
-
-    Map(const Map &other)
-        : m_rivers(other.m_rivers),
-          m_size(other.m_size),
-          m_territory_name(other.m_territory_name),
-          m_towns(other.m_towns),
-          directions_odd_column(other.directions_odd_column),
-          directions_even_column(other.directions_even_column) {
-        m_map = other.m_map;
-    }
-
-    Map(Map &&other) noexcept
-        : m_map(std::move(other.m_map)),
-          m_rivers(std::move(other.m_rivers)),
-          m_size(other.m_size),
-          m_towns(std::move(other.m_towns)),
-          m_territory_name(std::move(other.m_territory_name)),
-          directions_odd_column(other.directions_odd_column),
-          directions_even_column(other.directions_even_column) {
-    }
-
-    Map &operator=(const Map &other) {
-        m_map = other.m_map;
-        return *this;
+    // The standard map. data/json/map/map.json is parsed only once, by the
+    // first call of get_standard().
+    Map() : Map(get_standard()) {
     }
 
-    Map &operator=(Map &&other) noexcept {
-        m_map = std::move(other.m_map);
-        return *this;
+    explicit Map(const nlohmann::json &json) {
+        ::runebound::map::from_json(json, *this);
     }
 
+    Map(const Map &other) = default;
+    Map(Map &&other) noexcept = default;
+    Map &operator=(const Map &other) = default;
+    Map &operator=(Map &&other) noexcept = default;
     ~Map() = default;
 
     Map(int size,
-        std::vector<std::vector<MapCell>> map,
+        const std::vector<std::vector<MapCell>> &map,
         std::set<std::pair<Point, Point>> rivers,
-        std::map<std::string, std::vector<Point>> territory_name)
-        : m_size(size),
-          m_map(std::move(map)),
-          m_rivers(std::move(rivers)),
-          m_territory_name(std::move(territory_name)) {
-        find_towns();
-    }
+        std::map<std::string, std::vector<Point>> territory_name);
 
-    [[nodiscard]] std::set<Point> get_towns() const {
-        return m_towns;
+    static const Map &get_standard();
+
+    [[nodiscard]] const std::set<Point> &get_towns() const {
+        return m_layout->towns;
     }
 
     void make_boss(const Point &point) {
-        m_map[point.x][point.y].make_boss();
+        get_grid_for_change().make_boss(point);
     }
 
     void delete_boss(const Point &point) {
-        m_map[point.x][point.y].delete_boss();
+        get_grid_for_change().delete_boss(point);
     }
 
     [[nodiscard]] bool check_neighbour(const Point &lhs, const Point &rhs)
         const;
 
     [[nodiscard]] std::vector<std::vector<MapCell>> get_full_map() const {
-        return m_map;
+        return m_map->get_cells();
     }
 
     [[nodiscard]] std::vector<Point> get_territory_cells(
         const std::string &territory
-    ) {
-        if (m_territory_name.count(territory) == 0) {
+    ) const {
+        auto it = m_layout->territory_name.find(territory);
+        if (it == m_layout->territory_name.end()) {
             return {};
         }
-        return m_territory_name[territory];
+        return it->second;
     }
 
-    [[nodiscard]] MapCell get_cell_map(const Point &point) const {
-        return m_map[point.x][point.y];
+    [[nodiscard]] MapCellView get_cell_map(const Point &point) const {
+        return m_map->get_cell(point);
     }
 
     void reverse_token(const Point &point) {
-        m_map[point.x][point.y].reverse_token();
+        get_grid_for_change().reverse_token(point);
     }
 
-    [[nodiscard]] const std::vector<Point> &get_directions(const Point &point
-    ) const;
+    [[nodiscard]] const std::array<Point, COUNT_DIRECTIONS> &get_directions(
+        const Point &point
+    ) const {
+        return ::runebound::map::get_directions(point);
+    }
 
     [[nodiscard]] Point get_neighbour_in_direction(
         const Point &point,
@@ -154,18 +153,32 @@ public:
                (point.y + direction.y >= 0) && (point.y + direction.y < m_size);
     }
 
-    bool check_river(const Point &lhs_point, const Point &rhs_point) const {
-        return m_rivers.find({lhs_point, rhs_point}) != m_rivers.end();
+    [[nodiscard]] bool check_river(
+        const Point &lhs_point,
+        const Point &rhs_point
+    ) const;
+
+    [[nodiscard]] bool check_river_in_direction(
+        const Point &point,
+        int direction
+    ) const {
+        return (m_layout->river_directions[m_map->get_index(point)] >>
+                direction) &
+               1;
     }
 
-    [[nodiscard]] std::set<std::pair<Point, Point>> get_rivers() const {
-        return m_rivers;
+    [[nodiscard]] const std::set<std::pair<Point, Point>> &get_rivers() const {
+        return m_layout->rivers;
     }
 
     [[nodiscard]] int get_size() const {
         return m_size;
     }
 
+    [[nodiscard]] unsigned long long get_version() const {
+        return m_version;
+    }
+
     [[nodiscard]] std::vector<Point> check_move(
         const Point &start,
         const Point &end,
@@ -182,9 +195,7 @@ public:
     }
 
     static Map from_json(const nlohmann::json &json) {
-        Map map;
-        ::runebound::map::from_json(json, map);
-        return map;
+        return Map(json);
     }
 
     [[nodiscard]] std::vector<Point> get_neighbours(Point current) const;
@@ -193,6 +204,12 @@ public:
         Point start,
         std::vector<::runebound::dice::HandDice> dice_roll_results
     ) const;
+
+    // The cells of get_possible_moves as one bit per cell index.
+    [[nodiscard]] std::vector<bool> get_reachable_cells(
+        Point start,
+        std::vector<::runebound::dice::HandDice> dice_roll_results
+    ) const;
 };
 }  // namespace runebound::map
 
@@ -1,13 +1,13 @@
 #ifndef MAP_CLIENT_HPP_
 #define MAP_CLIENT_HPP_
 
-#include <fstream>
 #include <map>
 #include <nlohmann/json.hpp>
 #include <set>
 #include <string>
 #include "map.hpp"
 #include "map_cell.hpp"
+#include "map_grid.hpp"
 #include "point.hpp"
 #include "runebound_fwd.hpp"
 
@@ -19,55 +19,38 @@ struct MapClient {
 private:
     friend struct ::runebound::graphics::Board;
     friend struct ::runebound::graphics::Client;
-    const std::vector<Point> directions_odd_column{{-1, 0}, {0, 1},  {1, 1},
-                                                   {1, 0},  {1, -1}, {0, -1}};
-    const std::vector<Point> directions_even_column{{-1, 0}, {-1, 1}, {0, 1},
-                                                    {1, 0},  {0, -1}, {-1, -1}};
     std::map<std::string, std::vector<Point>> m_territory_name;
-    int m_size = STANDARD_SIZE;
+    int m_size = 0;
     std::set<std::pair<Point, Point>> m_rivers;
-    std::vector<std::vector<MapCell>> m_map;
-
-    [[nodiscard]] bool check_neighbour_in_direction(
-        const Point &cell,
-        const Point &direction
-    ) const;
+    MapGrid m_map;
 
     [[nodiscard]] std::vector<Point> get_all_neighbours(const Point &cell
     ) const;
 
 public:
-    MapClient() {
-        nlohmann::json json;
-        std::ifstream in("data/json/map/map.json");
-        in >> json;
-        ::runebound::map::from_json(json, *this);
-    }
-
-    explicit MapClient(const Map &map) {
-        m_map = map.m_map;
-        m_size = map.m_size;
-        m_territory_name = map.m_territory_name;
-        m_rivers = map.m_rivers;
+    // An empty map, filled by from_json with the map sent by the server.
+    MapClient() = default;
+
+    explicit MapClient(const Map &map)
+        : m_territory_name(map.m_layout->territory_name),
+          m_size(map.m_size),
+          m_rivers(map.m_layout->rivers),
+          m_map(*map.m_map) {
     }
 
     MapClient(const MapClient &) = default;
     MapClient(MapClient &&) = default;
-
-    MapClient &operator=(const MapClient &other) {
-        m_map = other.m_map;
-        return *this;
-    }
-
-    MapClient &operator=(MapClient &&other) {
-        m_map = other.m_map;
-        return *this;
-    }
+    MapClient &operator=(const MapClient &) = default;
+    MapClient &operator=(MapClient &&) = default;
 
     const std::map<std::string, std::vector<Point>> &get_territory_name() const;
     int get_size() const;
     const std::set<std::pair<Point, Point>> &get_rivers() const;
-    const std::vector<std::vector<MapCell>> &get_map() const;
+    const MapGrid &get_map() const;
+
+    [[nodiscard]] MapCellView get_cell_map(const Point &point) const {
+        return m_map.get_cell(point);
+    }
 
     friend void to_json(nlohmann::json &json, const MapClient &map);
 
@@ -0,0 +1,137 @@
+#ifndef MAP_GRID_HPP_
+#define MAP_GRID_HPP_
+
+#include <cstdint>
+#include <nlohmann/json_fwd.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "map_cell.hpp"
+#include "point.hpp"
+#include "runebound_fwd.hpp"
+
+namespace runebound::map {
+
+struct MapGrid;
+struct MapCellView;
+
+struct TooManyTerritoriesException : std::runtime_error {
+    TooManyTerritoriesException()
+        : std::runtime_error("A map can have at most 256 territory names") {
+    }
+};
+
+void to_json(nlohmann::json &json, const MapGrid &grid);
+void from_json(const nlohmann::json &json, MapGrid &grid);
+
+// Board cells stored as one byte array per field, indexed by
+// row * size + column. Territory names are interned into one-byte ids, so
+// a map has at most 256 of them, the empty name included.
+struct MapGrid {
+private:
+    friend struct MapCellView;
+    int m_size = 0;
+    std::vector<std::uint8_t> m_type_cell;
+    std::vector<std::uint8_t> m_special_type_cell;
+    std::vector<std::uint8_t> m_road;
+    std::vector<std::uint8_t> m_token;
+    std::vector<std::uint8_t> m_side_token;
+    std::vector<std::uint8_t> m_territory;
+    std::vector<std::string> m_territory_names;
+
+    void resize(int size);
+
+    void set_cell(std::size_t index, const MapCell &cell);
+
+    std::uint8_t intern_territory_name(const std::string &name);
+
+public:
+    MapGrid() = default;
+
+    explicit MapGrid(const std::vector<std::vector<MapCell>> &map);
+
+    [[nodiscard]] int get_size() const {
+        return m_size;
+    }
+
+    [[nodiscard]] std::size_t get_index(const Point &point) const {
+        return static_cast<std::size_t>(point.x * m_size + point.y);
+    }
+
+    [[nodiscard]] MapCellView get_cell(const Point &point) const;
+
+    [[nodiscard]] MapCellView get_cell(std::size_t index) const;
+
+    void make_boss(const Point &point) {
+        m_token[get_index(point)] =
+            static_cast<std::uint8_t>(AdventureType::BOSS);
+        m_side_token[get_index(point)] =
+            static_cast<std::uint8_t>(Side::FRONT);
+    }
+
+    void delete_boss(const Point &point) {
+        m_token[get_index(point)] =
+            static_cast<std::uint8_t>(AdventureType::NOTHING);
+    }
+
+    void reverse_token(const Point &point) {
+        m_side_token[get_index(point)] ^= 1;
+    }
+
+    [[nodiscard]] std::vector<std::vector<MapCell>> get_cells() const;
+
+    friend void to_json(nlohmann::json &json, const MapGrid &grid);
+    friend void from_json(const nlohmann::json &json, MapGrid &grid);
+};
+
+// Read-only view of one cell of a MapGrid with the getters of MapCell.
+// It is valid while the grid is alive and not resized.
+struct MapCellView {
+private:
+    const MapGrid *m_grid;
+    std::size_t m_index;
+
+public:
+    MapCellView(const MapGrid &grid, std::size_t index)
+        : m_grid(&grid), m_index(index) {
+    }
+
+    [[nodiscard]] TypeCell get_type_cell() const {
+        return static_cast<TypeCell>(m_grid->m_type_cell[m_index]);
+    }
+
+    [[nodiscard]] SpecialTypeCell get_special_type_cell() const {
+        return static_cast<SpecialTypeCell>(
+            m_grid->m_special_type_cell[m_index]
+        );
+    }
+
+    [[nodiscard]] bool check_road() const {
+        return m_grid->m_road[m_index] != 0;
+    }
+
+    [[nodiscard]] runebound::AdventureType get_token() const {
+        return static_cast<runebound::AdventureType>(m_grid->m_token[m_index]);
+    }
+
+    [[nodiscard]] runebound::Side get_side_token() const {
+        return static_cast<runebound::Side>(m_grid->m_side_token[m_index]);
+    }
+
+    [[nodiscard]] const std::string &get_territory_name() const {
+        return m_grid->m_territory_names[m_grid->m_territory[m_index]];
+    }
+
+    [[nodiscard]] MapCell to_map_cell() const;
+};
+
+inline MapCellView MapGrid::get_cell(const Point &point) const {
+    return {*this, get_index(point)};
+}
+
+inline MapCellView MapGrid::get_cell(std::size_t index) const {
+    return {*this, index};
+}
+
+}  // namespace runebound::map
+#endif  // MAP_GRID_HPP_
@@ -0,0 +1,72 @@
+#ifndef MAP_NEIGHBOURS_HPP_
+#define MAP_NEIGHBOURS_HPP_
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include "point.hpp"
+
+namespace runebound::map {
+
+const int STANDARD_SIZE = 15;
+const int COUNT_DIRECTIONS = 6;
+
+// Offsets of the neighbours of a cell, clockwise from the upper one. Cells of
+// odd columns are shifted half a cell down.
+inline constexpr std::array<Point, COUNT_DIRECTIONS> DIRECTIONS_ODD_COLUMN{
+    {{-1, 0}, {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}}};
+inline constexpr std::array<Point, COUNT_DIRECTIONS> DIRECTIONS_EVEN_COLUMN{
+    {{-1, 0}, {-1, 1}, {0, 1}, {1, 0}, {0, -1}, {-1, -1}}};
+
+constexpr const std::array<Point, COUNT_DIRECTIONS> &get_directions(
+    const Point &point
+) {
+    if (point.y % 2 == 0) {
+        return DIRECTIONS_EVEN_COLUMN;
+    }
+    return DIRECTIONS_ODD_COLUMN;
+}
+
+const std::int16_t NO_NEIGHBOUR = -1;
+
+// Indices row * size + column of the neighbours of a cell in the order of
+// get_directions(cell), NO_NEIGHBOUR where the direction leaves the board.
+using Neighbours = std::array<std::int16_t, COUNT_DIRECTIONS>;
+
+constexpr Neighbours get_cell_neighbours(int size, const Point &cell) {
+    Neighbours neighbours{};
+    const auto &directions = get_directions(cell);
+    for (int direction = 0; direction < COUNT_DIRECTIONS; ++direction) {
+        auto next = cell + directions[direction];
+        if (next.x < 0 || next.x >= size || next.y < 0 || next.y >= size) {
+            neighbours[direction] = NO_NEIGHBOUR;
+        } else {
+            neighbours[direction] =
+                static_cast<std::int16_t>(next.x * size + next.y);
+        }
+    }
+    return neighbours;
+}
+
+template <int size>
+constexpr std::array<Neighbours, size * size> make_neighbour_table() {
+    std::array<Neighbours, size * size> table{};
+    for (int row = 0; row < size; ++row) {
+        for (int column = 0; column < size; ++column) {
+            table[row * size + column] =
+                get_cell_neighbours(size, Point(row, column));
+        }
+    }
+    return table;
+}
+
+inline constexpr auto STANDARD_NEIGHBOUR_TABLE =
+    make_neighbour_table<STANDARD_SIZE>();
+
+// Neighbours of every cell of a size x size board. The standard board uses
+// the table built at compile time; tables of other sizes are built on
+// first use and kept for the rest of the run.
+[[nodiscard]] std::span<const Neighbours> get_neighbour_table(int size);
+
+}  // namespace runebound::map
+#endif  // MAP_NEIGHBOURS_HPP_
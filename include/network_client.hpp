@@ -5,12 +5,15 @@
 
 #include <boost/asio.hpp>
 #include <chrono>
+#include <deque>
+#include <functional>
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <thread>
 #include <utility>
 #include "fight_client.hpp"
 #include "game_client.hpp"
+#include "wire_format.hpp"
 
 using boost::asio::ip::tcp;
 using json = nlohmann::json;
@@ -23,7 +26,8 @@ public:
         boost::asio::io_context &io_context,
         const std::string &host,
         int port,
-        std::string user_name
+        std::string user_name,
+        WireFormat wire_format = WireFormat::PACKED
     )
         : socket_(io_context),
           m_user_name(std::move(user_name)),
@@ -31,8 +35,13 @@ public:
         tcp::resolver resolver(io_context);
         auto endpoints =
             tcp::endpoint(boost::asio::ip::address::from_string(host), port);
-        socket_.async_connect(endpoints, [this](boost::system::error_code ec) {
+        socket_.async_connect(endpoints, [this, wire_format](
+                                             boost::system::error_code ec
+                                         ) {
             if (!ec) {
+                if (wire_format != WireFormat::JSON) {
+                    set_wire_format(wire_format);
+                }
                 do_read();
             } else {
                 std::cerr << "Connect failed: " << ec.message() << std::endl;
@@ -41,8 +50,11 @@ public:
     }
 
 private:
-    void parse_message(std::string &message) {
-        json answer = json::parse(message);
+    void parse_message(std::string_view frame) {
+        json answer = decode_message(frame, m_read_format);
+        if (answer["change type"] == "wire format") {
+            m_read_format = wire_format_from_string(answer["wire format"]);
+        }
         if (answer["change type"] == "game names") {
             game_names = answer["game names"];
         }
@@ -50,7 +62,27 @@ private:
 #ifdef NETWORK_DEBUG_INFO
             std::cout << "Game changed, maybe\n";
 #endif
-            runebound::game::from_json(answer, m_game_client);
+            m_game_version = answer["version"];
+            m_resync_pending = false;
+            m_game_state = answer;
+            m_game_state.erase("change type");
+            m_game_state.erase("version");
+            runebound::game::from_json(m_game_state, m_game_client);
+        }
+        if (answer["change type"] == "game patch") {
+            // Patches that come while the whole game is on its way do not
+            // apply to the state we have, so they are dropped.
+            if (m_resync_pending) {
+                return;
+            }
+            if (answer["version"] != m_game_version + 1) {
+                m_resync_pending = true;
+                resync();
+                return;
+            }
+            m_game_version = answer["version"];
+            m_game_state = m_game_state.patch(answer["patch"]);
+            runebound::game::from_json(m_game_state, m_game_client);
         }
         if (answer["change type"] == "exception") {
             std::cout << "Exception: " << answer["exception"] << "\n";
@@ -59,21 +91,30 @@ private:
             m_character = answer["character"];
         }
         game_need_update = true;
+        if (m_message_handler) {
+            m_message_handler(answer);
+        }
     }
 
     void do_read() {
-        boost::asio::async_read_until(
-            socket_, m_buffer, '\n',
-            [this](boost::system::error_code ec, std::size_t length) {
-                if (!ec) {
-                    std::istream is(&m_buffer);
-                    std::string message;
-                    std::getline(is, message);
+        std::string_view bytes(
+            static_cast<const char *>(m_buffer.data().data()), m_buffer.size()
+        );
+        auto frame_size = get_frame_size(bytes, m_read_format);
+        if (frame_size != 0) {
 #ifdef NETWORK_DEBUG_INFO
-                    std::cout << "Received: " << message.substr(0, 80)
-                              << " Length: " << length << '\n';
+            std::cout << "Received: " << frame_size << " bytes\n";
 #endif
-                    parse_message(message);
+            m_received_bytes += frame_size;
+            parse_message(bytes.substr(0, frame_size));
+            m_buffer.consume(frame_size);
+            do_read();
+            return;
+        }
+        boost::asio::async_read(
+            socket_, m_buffer, boost::asio::transfer_at_least(1),
+            [this](boost::system::error_code ec, std::size_t) {
+                if (!ec) {
                     do_read();
                 } else {
                     std::cout << "Disconnected" << std::endl;
@@ -82,19 +123,69 @@ private:
         );
     }
 
-    void do_write(const std::string &message) {
-        socket_.async_write_some(
-            boost::asio::buffer(message + '\n'),
-            [this, message](boost::system::error_code ec, std::size_t length) {
-                if (!ec) {
-#ifdef NETWORK_DEBUG_INFO
-                    std::cout << "Sent:" << message.substr(0, 80) << ' '
-                              << length << '\n';
-#endif
+    // Messages after this one are written in the format; the answer of the
+    // server switches reading.
+    void set_wire_format(WireFormat format) {
+        json data;
+        data["action type"] = "set wire format";
+        data["wire format"] = to_string(format);
+        do_write(data);
+        m_write_format = format;
+    }
+
+    void do_write(const json &data) {
+        auto message = encode_message(data, m_write_format);
+        // Dropping the message would lose an action silently, so the
+        // connection is closed instead, as the server does. The write in
+        // progress then fails and empties the queue.
+        if (m_write_queue_bytes + message.size() > MAX_WRITE_QUEUE_BYTES) {
+            std::cerr << "Write queue overflow, closing connection"
+                      << std::endl;
+            boost::system::error_code ec;
+            socket_.close(ec);
+            return;
+        }
+        m_sent_bytes += message.size();
+        m_write_queue.push_back(std::move(message));
+        m_write_queue_bytes += m_write_queue.back().size();
+        if (!m_write_in_progress) {
+            write_queue();
+        }
+    }
 
-                } else {
+    void write_queue() {
+        m_write_in_progress = true;
+        std::vector<boost::asio::const_buffer> buffers;
+        buffers.reserve(m_write_queue.size());
+        for (const auto &message : m_write_queue) {
+            buffers.push_back(boost::asio::buffer(message));
+        }
+        boost::asio::async_write(
+            socket_, buffers,
+            [this, count_messages = buffers.size()](
+                boost::system::error_code ec,
+                [[maybe_unused]] std::size_t length
+            ) {
+                if (ec) {
                     std::cerr << "Write failed: " << ec.message() << std::endl;
+                    m_write_queue.clear();
+                    m_write_queue_bytes = 0;
+                    m_write_in_progress = false;
                     socket_.close();
+                    return;
+                }
+#ifdef NETWORK_DEBUG_INFO
+                std::cout << "Sent: " << count_messages << " messages, "
+                          << length << " bytes\n";
+#endif
+                for (std::size_t i = 0; i < count_messages; ++i) {
+                    m_write_queue_bytes -= m_write_queue.front().size();
+                    m_write_queue.pop_front();
+                }
+                if (!m_write_queue.empty()) {
+                    write_queue();
+                } else {
+                    m_write_in_progress = false;
                 }
             }
         );
@@ -104,14 +195,14 @@ public:
     void take_token() {
         json data;
         data["action type"] = "take token";
-        do_write(data.dump());
+        do_write(data);
     }
 
     void add_game(const std::string &game_name) {
         json data;
         data["action type"] = "add game";
         data["game name"] = game_name;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void join_game(const std::string &game_name) {
@@ -119,14 +210,14 @@ public:
         data["action type"] = "join game";
         data["game name"] = game_name;
         data["user name"] = m_user_name;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void select_character(runebound::character::StandardCharacter character) {
         json data;
         data["action type"] = "select character";
         data["character"] = character;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void select_free_character(runebound::character::StandardCharacter character
@@ -134,13 +225,13 @@ public:
         json data;
         data["action type"] = "select free character";
         data["character"] = character;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void throw_move_dice() {
         json data;
         data["action type"] = "throw move dice";
-        do_write(data.dump());
+        do_write(data);
     }
 
     void make_move(int x, int y) {
@@ -148,38 +239,38 @@ public:
         data["action type"] = "make move";
         data["x"] = x;
         data["y"] = y;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void exit_game() {
         json data;
         data["action type"] = "exit_game";
-        do_write(data.dump());
+        do_write(data);
     }
 
     void exit_game_and_replace_with_bot() {
         json data;
         data["action type"] = "exit_game_and_replace_with_bot";
-        do_write(data.dump());
+        do_write(data);
     }
 
     void relax() {
         json data;
         data["action type"] = "relax";
-        do_write(data.dump());
+        do_write(data);
     }
 
     void pass() {
         json data;
         data["action type"] = "pass";
-        do_write(data.dump());
+        do_write(data);
     }
 
     void fight_end_fight() {
         json data;
         data["action type"] = "fight";
         data["fight command"] = "end fight";
-        do_write(data.dump());
+        do_write(data);
     }
 
     void fight_make(
@@ -194,7 +285,7 @@ public:
         data["participant"] = participant;
         data["tokens_me"] = tokens_me;
         data["tokens_enemy"] = tokens_enemy;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void fight_pass(runebound::fight::Participant participant) {
@@ -202,7 +293,7 @@ public:
         data["action type"] = "fight";
         data["fight command"] = "fight_pass";
         data["participant"] = participant;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void
@@ -212,14 +303,14 @@ public:
         data["adventure command"] = "start_card_execution";
         data["card"] = card;
         data["type"] = type;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void throw_research_dice() {
         json data;
         data["action type"] = "adventure";
         data["adventure command"] = "throw_research_dice";
-        do_write(data.dump());
+        do_write(data);
     }
 
     void complete_card_research(std::size_t outcome) {
@@ -227,7 +318,7 @@ public:
         data["action type"] = "adventure";
         data["adventure command"] = "complete_card_research";
         data["outcome"] = outcome;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void check_characteristic(unsigned int card, cards::OptionMeeting option) {
@@ -236,14 +327,14 @@ public:
         data["adventure command"] = "check_characteristic";
         data["card"] = card;
         data["option"] = option;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void start_trade() {
         json data;
         data["action type"] = "trade";
         data["trade command"] = "start_trade";
-        do_write(data.dump());
+        do_write(data);
     }
 
     void sell_product_in_town(unsigned int product) {
@@ -251,7 +342,7 @@ public:
         data["action type"] = "trade";
         data["trade command"] = "sell_product_in_town";
         data["product"] = product;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void buy_product(unsigned int product) {
@@ -259,7 +350,7 @@ public:
         data["action type"] = "trade";
         data["trade command"] = "buy_product";
         data["product"] = product;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void sell_product_in_special_cell(unsigned int product) {
@@ -267,7 +358,7 @@ public:
         data["action type"] = "trade";
         data["trade command"] = "sell_product_in_special_cell";
         data["product"] = product;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void discard_product(unsigned int product) {
@@ -275,13 +366,19 @@ public:
         data["action type"] = "trade";
         data["trade command"] = "discard_product";
         data["product"] = product;
-        do_write(data.dump());
+        do_write(data);
     }
 
     void add_bot() {
         json data;
         data["action type"] = "add_bot";
-        do_write(data.dump());
+        do_write(data);
+    }
+
+    void resync() {
+        json data;
+        data["action type"] = "resync";
+        do_write(data);
     }
 
     [[nodiscard]] std::vector<dice::HandDice> get_last_dice_result() const {
@@ -302,6 +399,19 @@ public:
         return nullptr;
     }
 
+    // Called on the thread of the io_context after every received message.
+    void set_message_handler(std::function<void(const json &)> handler) {
+        m_message_handler = std::move(handler);
+    }
+
+    [[nodiscard]] std::size_t get_received_bytes() const {
+        return m_received_bytes;
+    }
+
+    [[nodiscard]] std::size_t get_sent_bytes() const {
+        return m_sent_bytes;
+    }
+
     [[nodiscard]] const std::vector<std::string> &get_game_names() const {
         return game_names;
     }
@@ -353,9 +463,21 @@ public:
     runebound::game::GameClient m_game_client;
 
 private:
+    unsigned long long m_game_version = 0;
+    bool m_resync_pending = false;
+    json m_game_state;
+    static constexpr std::size_t MAX_WRITE_QUEUE_BYTES = 1024 * 1024;
+    std::deque<std::string> m_write_queue;
+    std::size_t m_write_queue_bytes = 0;
+    bool m_write_in_progress = false;
+    WireFormat m_read_format = WireFormat::JSON;
+    WireFormat m_write_format = WireFormat::JSON;
+    std::function<void(const json &)> m_message_handler;
+    std::size_t m_received_bytes = 0;
+    std::size_t m_sent_bytes = 0;
     boost::asio::streambuf m_buffer;
     tcp::socket socket_;
     boost::asio::io_context &io_context_;
 };
 }  // namespace runebound::network
-#endif  // CLIENT_HPP_
\ No newline at end of file
+#endif  // CLIENT_HPP_
\ No newline at end of file
@@ -3,33 +3,124 @@
 #define NETWORK_SERVER_HPP
 
 #include <boost/asio.hpp>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
 #include "character.hpp"
+#include "game.hpp"
+#include "game_client.hpp"
+#include "game_journal.hpp"
 #include "runebound_fwd.hpp"
+#include "wire_format.hpp"
 
 using boost::asio::ip::tcp;
 
+// A game together with everything the server keeps for it. Apart from the
+// name, all of it is accessed only from the strand of the room, so actions
+// of different games run in parallel and actions of one game do not.
+struct GameRoom : std::enable_shared_from_this<GameRoom> {
+    struct User {
+        std::weak_ptr<Connection> connection;
+        bool need_full_game = true;
+    };
+
+    GameRoom(
+        boost::asio::io_context &io_context,
+        std::string game_name,
+        const std::filesystem::path &save_folder,
+        unsigned long long journal_sequence = 0
+    )
+        : strand(boost::asio::make_strand(io_context)),
+          name(std::move(game_name)),
+          journal(save_folder, name, journal_sequence),
+          save_timer(strand) {
+    }
+
+    // Journals the action of the character and makes it in the game. The
+    // random generator is reseeded before and the seed is journaled, so
+    // replaying the journal over the last snapshot repeats the game. An
+    // action is journaled before it is made: one that throws after changing
+    // the game or drawing from the generator throws at the same point when
+    // it is replayed, and leaves the same changes behind.
+    void play(
+        const std::shared_ptr<runebound::character::Character> &character,
+        nlohmann::json &action
+    );
+
+    boost::asio::strand<boost::asio::io_context::executor_type> strand;
+    const std::string name;
+    runebound::game::Game game;
+    runebound::game::GameClientSnapshot snapshot;
+    std::map<std::string, User> users;
+    runebound::network::GameJournal journal;
+    boost::asio::steady_timer save_timer;
+    bool save_scheduled = false;
+};
+
 class Connection : public std::enable_shared_from_this<Connection> {
 public:
     friend struct runebound::bot::Bot;
-    explicit Connection(tcp::socket socket) : socket_(std::move(socket)){};
+    // The socket should use its own strand as executor: reads and writes of
+    // a connection are started from the strands of different rooms.
+    Connection(tcp::socket socket, boost::asio::io_context &io_context)
+        : socket_(std::move(socket)), m_io_context(io_context){};
     void start();
 
+    [[nodiscard]] std::size_t get_write_queue_bytes() const {
+        return m_write_queue_bytes;
+    }
+
 private:
+    // Shared by every connection it is sent to, whatever their formats.
+    using Message = std::shared_ptr<const runebound::network::OutgoingMessage>;
+
+    // A connection whose unsent messages grow beyond this is too slow to
+    // keep up with the game and is closed.
+    static constexpr std::size_t MAX_WRITE_QUEUE_BYTES = 4 * 1024 * 1024;
+
+    static Message make_message(const nlohmann::json &data);
+    static Message make_game_message(
+        const runebound::game::GameClientSnapshot &snapshot
+    );
+    static Message make_game_names_message();
+
     void send_game_names();
+    void send_exception(const std::string &what);
     void send_selected_character(
         runebound::character::StandardCharacter character
     );
     void send_game_for_all();
+    static void send_game_for_all(GameRoom &room);
+    void send_game();
 
-    void write(const std::string &message);
-    void parse_message(std::string &message);
+    void write(Message message);
+    void queue_message(Message message);
+    void do_write();
+    void parse_message(const std::string &frame);
+    void set_wire_format(const nlohmann::json &data);
+    void handle_action(nlohmann::json &data);
+    void leave_room();
+    void disconnect();
     void do_read();
     void play_as_bot();
     boost::asio::streambuf m_buffer;
     std::string m_user_name;
-    std::string m_game_name;
+    std::shared_ptr<GameRoom> m_room;
     runebound::game::Game *m_game = nullptr;
+    std::shared_ptr<runebound::character::Character> m_character;
+    // Messages waiting to be sent with their frames in the format the
+    // connection had when they were queued.
+    std::deque<std::pair<Message, const std::string *>> m_write_queue;
+    std::size_t m_write_queue_bytes = 0;
+    bool m_write_in_progress = false;
+    runebound::network::WireFormat m_read_format =
+        runebound::network::WireFormat::JSON;
+    runebound::network::WireFormat m_write_format =
+        runebound::network::WireFormat::JSON;
     tcp::socket socket_;
+    boost::asio::io_context &m_io_context;
 };
 
 #endif  // NETWORK_SERVER_HPP
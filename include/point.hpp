@@ -1,6 +1,7 @@
 #ifndef POINT_HPP_
 #define POINT_HPP_
 #include <nlohmann/json.hpp>
+#include "runebound_fwd.hpp"
 
 namespace runebound {
 
@@ -13,14 +14,14 @@ public:
 
     Point() = default;
 
-    Point(int x_, int y_) : x(x_), y(y_) {
+    constexpr Point(int x_, int y_) : x(x_), y(y_) {
     }
 
-    bool operator<(const Point &point) const {
+    constexpr bool operator<(const Point &point) const {
         return (x < point.x) || (x == point.x && y < point.y);
     }
 
-    bool operator==(const Point &point) const {
+    constexpr bool operator==(const Point &point) const {
         return x == point.x && y == point.y;
     }
 
@@ -34,7 +35,7 @@ public:
         point.y = json["y"];
     }
 
-    friend Point operator+(const Point &lhs, const Point &rhs) {
+    friend constexpr Point operator+(const Point &lhs, const Point &rhs) {
         return Point(lhs.x + rhs.x, lhs.y + rhs.y);
     }
 };
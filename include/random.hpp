@@ -0,0 +1,83 @@
+#ifndef RANDOM_HPP_
+#define RANDOM_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <random>
+
+namespace runebound {
+
+// xoshiro256** generator. Every game owns one and saves its state, so a game
+// replays the same way from its seed and games on different threads never
+// share a generator.
+struct Random {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Random(std::uint64_t seed = 0) {
+        this->seed(seed);
+    }
+
+    // Expands the seed with splitmix64, as the authors of xoshiro advise.
+    void seed(std::uint64_t seed) {
+        for (auto &word : m_state) {
+            seed += 0x9e3779b97f4a7c15;
+            auto mixed = seed;
+            mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111eb;
+            word = mixed ^ (mixed >> 31);
+        }
+    }
+
+    result_type operator()() {
+        auto result = rotate_left(m_state[1] * 5, 7) * 9;
+        auto shifted = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= shifted;
+        m_state[3] = rotate_left(m_state[3], 45);
+        return result;
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    // A seed for games that are not given one.
+    static std::uint64_t make_seed() {
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32) ^ device() ^
+               static_cast<std::uint64_t>(
+                   std::chrono::steady_clock::now().time_since_epoch().count()
+               );
+    }
+
+    bool operator==(const Random &random) const = default;
+
+    friend void to_json(nlohmann::json &json, const Random &random) {
+        json = random.m_state;
+    }
+
+    friend void from_json(const nlohmann::json &json, Random &random) {
+        random.m_state = json.get<std::array<std::uint64_t, 4>>();
+    }
+
+private:
+    static constexpr std::uint64_t rotate_left(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::array<std::uint64_t, 4> m_state{};
+};
+
+}  // namespace runebound
+#endif  // RANDOM_HPP_
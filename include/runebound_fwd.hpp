@@ -2,22 +2,21 @@
 #define RUNEBOUND_FWD_HPP_
 
 #include <chrono>
+#include <functional>
 #include <map>
 #include <random>
 #include <set>
+#include <thread>
 
 namespace runebound {
 enum class AdventureType { MEETING, RESEARCH, FIGHT, NOTHING, BOSS };
 
 enum class Side { FRONT, BACK };
 
-static std::mt19937 rng(
-    std::chrono::steady_clock::now().time_since_epoch().count()
-);
-
 enum class Characteristic { BODY, INTELLIGENCE, SPIRIT };
 
 struct Point;
+struct Random;
 
 namespace character {
 struct Character;
@@ -0,0 +1,65 @@
+#ifndef SAVE_SERVICE_HPP_
+#define SAVE_SERVICE_HPP_
+
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace runebound::network {
+
+// Writes game saves on its own thread, so the network threads never wait
+// for the disk. A save replaces a pending save of the same game, and every
+// file is written to a temporary file first and then renamed, so a crash
+// leaves either the old or the new save but never a broken one.
+class SaveService {
+public:
+    explicit SaveService(std::filesystem::path folder);
+
+    SaveService(const SaveService &) = delete;
+    SaveService &operator=(const SaveService &) = delete;
+
+    // Writes the pending saves and stops the thread.
+    ~SaveService();
+
+    // on_saved is called on the thread of the service once the file is
+    // written. When a pending save is replaced, only the callback of the
+    // newer one is called.
+    void save(
+        const std::string &game_name,
+        std::string data,
+        std::function<void()> on_saved = nullptr
+    );
+
+    // Blocks until every save requested before the call is on disk.
+    void flush();
+
+    [[nodiscard]] std::filesystem::path get_path(const std::string &game_name
+    ) const {
+        return m_folder / (game_name + ".json");
+    }
+
+private:
+    void run();
+    struct PendingSave {
+        std::string data;
+        std::function<void()> on_saved;
+    };
+
+    bool write_file(const std::string &game_name, const std::string &data)
+        const;
+
+    std::filesystem::path m_folder;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::map<std::string, PendingSave> m_pending;
+    bool m_writing = false;
+    bool m_stopped = false;
+    std::thread m_thread;
+};
+}  // namespace runebound::network
+
+#endif  // SAVE_SERVICE_HPP_
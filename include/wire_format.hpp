@@ -0,0 +1,61 @@
+#ifndef WIRE_FORMAT_HPP_
+#define WIRE_FORMAT_HPP_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+
+namespace runebound::network {
+
+// How messages are written to a connection. Every connection starts with
+// JSON, one message per line, and may switch with a "set wire format"
+// action. The other formats are framed by the big-endian 32-bit length of
+// the message:
+// - CBOR and MSGPACK are the encodings of nlohmann::json;
+// - PACKED is CBOR where every object is an array of its values and a
+//   shape id, and the keys of each shape are sent once per message.
+enum class WireFormat { JSON, CBOR, MSGPACK, PACKED };
+
+const std::size_t COUNT_WIRE_FORMATS = 4;
+
+// Longer messages are treated as a broken stream.
+const std::size_t MAX_MESSAGE_BYTES = 16 * 1024 * 1024;
+
+[[nodiscard]] std::string to_string(WireFormat format);
+
+[[nodiscard]] WireFormat wire_format_from_string(const std::string &name);
+
+// Returns the whole frame of the message: the line or the length and the
+// encoded message.
+[[nodiscard]] std::string
+encode_message(const nlohmann::json &data, WireFormat format);
+
+// Returns the size of the first frame in bytes or 0 if bytes do not hold
+// the whole frame yet.
+[[nodiscard]] std::size_t
+get_frame_size(std::string_view bytes, WireFormat format);
+
+[[nodiscard]] nlohmann::json
+decode_message(std::string_view frame, WireFormat format);
+
+// Message sent to many connections. It is encoded once per format, by the
+// first connection that needs it, so it can be shared between threads.
+class OutgoingMessage {
+public:
+    explicit OutgoingMessage(nlohmann::json data) : m_data(std::move(data)) {
+    }
+
+    [[nodiscard]] const std::string &get_frame(WireFormat format) const;
+
+private:
+    nlohmann::json m_data;
+    mutable std::array<std::once_flag, COUNT_WIRE_FORMATS> m_encoded;
+    mutable std::array<std::string, COUNT_WIRE_FORMATS> m_frames;
+};
+
+}  // namespace runebound::network
+#endif  // WIRE_FORMAT_HPP_
@@ -1,4 +1,5 @@
 #include "card_research.hpp"
+#include <array>
 #include <nlohmann/json.hpp>
 #include "map.hpp"
 
@@ -12,30 +13,47 @@ bool CardResearch::check_completion_task(const Point &cell) {
     return m_completed;
 }
 
+// By Hall's theorem the terrains can be given distinct dice if and only if,
+// for every set of terrains, the dice entering one of them are at least as
+// many as the terrains of the set needed. There are only 2^COUNT_TERRAINS
+// sets, so no order of the dice has to be tried.
 bool CardResearch::check_outcome(
     int index,
-    std::vector<::runebound::dice::HandDice> &result_dice
+    const std::vector<::runebound::dice::HandDice> &result_dice
 ) const {
-    do {
-        bool completed = true;
-        for (std::size_t i = 0;
-             i <
-             std::min(
-                 result_dice.size(), m_outcomes[index].m_necessary_result.size()
-             );
-             ++i) {
-            if (!::runebound::dice::check_hand_dice(
-                    m_outcomes[index].m_necessary_result[i], result_dice[i]
-                )) {
-                completed = false;
-                break;
+    using ::runebound::dice::COUNT_FACES;
+    using ::runebound::dice::COUNT_TERRAINS;
+    const auto &necessary_result = m_outcomes[index].m_necessary_result;
+    std::array<int, COUNT_TERRAINS> needed{};
+    std::array<int, COUNT_FACES> thrown{};
+    for (std::size_t i = 0;
+         i < std::min(result_dice.size(), necessary_result.size()); ++i) {
+        ++needed[static_cast<int>(necessary_result[i])];
+    }
+    for (auto dice : result_dice) {
+        ++thrown[static_cast<int>(dice)];
+    }
+    for (int terrains = 1; terrains < (1 << COUNT_TERRAINS); ++terrains) {
+        int count_needed = 0;
+        for (int type = 0; type < COUNT_TERRAINS; ++type) {
+            if ((terrains >> type) & 1) {
+                count_needed += needed[type];
             }
         }
-        if (completed) {
-            return true;
+        int count_entering = 0;
+        for (int face = 0; face < COUNT_FACES; ++face) {
+            if (::runebound::dice::get_terrain_mask(
+                    static_cast<::runebound::dice::HandDice>(face)
+                ) &
+                terrains) {
+                count_entering += thrown[face];
+            }
+        }
+        if (count_needed > count_entering) {
+            return false;
         }
-    } while (std::next_permutation(result_dice.begin(), result_dice.end()));
-    return false;
+    }
+    return true;
 }
 
 void to_json(nlohmann::json &json, const CardResearch &card) {
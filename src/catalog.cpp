@@ -0,0 +1,72 @@
+#include "catalog.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include "map.hpp"
+
+namespace runebound::game {
+
+namespace {
+std::vector<nlohmann::json> read_folder(const std::string &path) {
+    std::vector<std::filesystem::path> files;
+    for (const auto &entry : std::filesystem::directory_iterator(path)) {
+        files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+    std::vector<nlohmann::json> result;
+    for (const auto &file : files) {
+        std::ifstream in(file);
+        in >> result.emplace_back();
+    }
+    return result;
+}
+
+template <typename T>
+void fill_vector(const nlohmann::json &json, std::vector<T> &vec) {
+    vec.clear();
+    for (const auto &elem : json) {
+        vec.push_back(elem);
+    }
+}
+}  // namespace
+
+std::shared_ptr<const Catalog>
+Catalog::load(const std::string &folder, map::Map &map) {
+    nlohmann::json json;
+    json["m_all_cards_research"] = read_folder(folder + "/cards/cards_research");
+    json["m_all_cards_fight"] = read_folder(folder + "/cards/cards_fight");
+    json["m_all_cards_meeting"] = read_folder(folder + "/cards/cards_meeting");
+    json["m_all_products"] = read_folder(folder + "/products");
+    auto catalog = std::make_shared<Catalog>();
+    from_json(json, *catalog, map);
+    return catalog;
+}
+
+std::shared_ptr<const Catalog> Catalog::get_standard() {
+    static const std::shared_ptr<const Catalog> catalog = []() {
+        map::Map map;
+        return load("data/json", map);
+    }();
+    return catalog;
+}
+
+void to_json(nlohmann::json &json, const Catalog &catalog) {
+    json["m_all_cards_research"] = catalog.m_cards_research;
+    json["m_all_cards_fight"] = catalog.m_cards_fight;
+    json["m_all_cards_meeting"] = catalog.m_cards_meeting;
+    json["m_all_products"] = catalog.m_products;
+}
+
+void from_json(const nlohmann::json &json, Catalog &catalog, map::Map &map) {
+    catalog.m_cards_research.clear();
+    for (const auto &json_card_research : json["m_all_cards_research"]) {
+        cards::CardResearch card;
+        from_json(json_card_research, card, map);
+        catalog.m_cards_research.push_back(card);
+    }
+    fill_vector(json["m_all_cards_fight"], catalog.m_cards_fight);
+    fill_vector(json["m_all_cards_meeting"], catalog.m_cards_meeting);
+    fill_vector(json["m_all_products"], catalog.m_products);
+}
+}  // namespace runebound::game
@@ -1,54 +1,52 @@
 #include "dice.hpp"
+#include <cstddef>
 #include <vector>
 #include "map_cell.hpp"
 #include "point.hpp"
+#include "random.hpp"
 
 namespace runebound {
 namespace dice {
 
-HandDice throw_dice() {
-    unsigned int result = ::runebound::rng() % 6;
-    return static_cast<HandDice>(result);
+namespace {
+// A 32-bit word is a fraction in [0, 1). Multiplying it by COUNT_FACES puts
+// a face above bit 32 and leaves the next fraction below it, so every half
+// of a draw gives FACES_PER_WORD faces without rejection. Each product drops
+// a low bit of randomness, so a face is uniform up to a bias below 2^-26.
+const int FACES_PER_WORD = 3;
+const std::uint64_t LOW_WORD = 0xffffffff;
+
+HandDice extract_face(std::uint64_t &word) {
+    word *= COUNT_FACES;
+    auto face = static_cast<HandDice>(word >> 32);
+    word &= LOW_WORD;
+    return face;
 }
+}  // namespace
 
-std::vector<HandDice> get_combination_of_dice(unsigned int count_throws) {
-    std::vector<HandDice> result_of_throws(count_throws);
-    for (unsigned int number_dice = 0; number_dice < count_throws;
-         ++number_dice) {
-        result_of_throws[number_dice] = throw_dice();
-    }
-    return result_of_throws;
+HandDice throw_dice(Random &random) {
+    auto word = random() & LOW_WORD;
+    return extract_face(word);
 }
 
-bool check_hand_dice(
-    ::runebound::map::TypeCell type,
-    ::runebound::dice::HandDice dice
-) {
-    switch (type) {
-        case (::runebound::map::TypeCell::WATER):
-            return dice == ::runebound::dice::HandDice::MOUNTAINS_WATER ||
-                   dice == ::runebound::dice::HandDice::JOKER;
-        case (::runebound::map::TypeCell::FOREST):
-            return dice == ::runebound::dice::HandDice::FOREST_HILLS ||
-                   dice == ::runebound::dice::HandDice::PLAIN_FOREST ||
-                   dice == ::runebound::dice::HandDice::JOKER;
-        case (::runebound::map::TypeCell::MOUNTAINS):
-            return dice == ::runebound::dice::HandDice::MOUNTAINS_WATER ||
-                   dice == ::runebound::dice::HandDice::JOKER;
-        case (::runebound::map::TypeCell::HILLS):
-            return dice == ::runebound::dice::HandDice::FOREST_HILLS ||
-                   dice == ::runebound::dice::HandDice::HILLS_PLAIN ||
-                   dice == ::runebound::dice::HandDice::JOKER;
-        case (::runebound::map::TypeCell::PLAIN):
-            return dice == ::runebound::dice::HandDice::PLAIN ||
-                   dice == ::runebound::dice::HandDice::PLAIN_FOREST ||
-                   dice == ::runebound::dice::HandDice::HILLS_PLAIN ||
-                   dice == ::runebound::dice::HandDice::JOKER;
-        case (::runebound::map::TypeCell::TOWN):
-            return true;
-        default:
-            return dice == ::runebound::dice::HandDice::JOKER;
+void throw_dice(std::span<HandDice> faces, Random &random) {
+    std::size_t index = 0;
+    while (index < faces.size()) {
+        auto draw = random();
+        for (auto word : {draw & LOW_WORD, draw >> 32}) {
+            for (int face = 0; face < FACES_PER_WORD && index < faces.size();
+                 ++face) {
+                faces[index++] = extract_face(word);
+            }
+        }
     }
 }
+
+std::vector<HandDice>
+get_combination_of_dice(unsigned int count_throws, Random &random) {
+    std::vector<HandDice> result_of_throws(count_throws);
+    throw_dice(result_of_throws, random);
+    return result_of_throws;
+}
 }  // namespace dice
 }  // namespace runebound
\ No newline at end of file
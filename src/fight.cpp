@@ -1,30 +1,28 @@
 #include "fight.hpp"
 #include <vector>
 #include "game.hpp"
+#include "random.hpp"
 
 namespace runebound::fight {
 
 bool Fight::make_damage(Participant participant, int damage) {
-    if (participant == Participant::CHARACTER) {
-        std::vector<TokenHandCount> shields;
-        for (std::size_t i = 0; i < m_character_remaining_tokens.size(); ++i) {
-            if (m_character_remaining_tokens[i].hand ==
-                HandFightTokens::SHIELD) {
-                auto harm =
-                    std::min(m_character_remaining_tokens[i].count, damage);
-                damage -= harm;
-                m_character_remaining_tokens[i].count -= harm;
-                if (m_character_remaining_tokens[i].count == 0) {
-                    shields.push_back(m_character_remaining_tokens[i]);
-                }
-                if (damage == 0) {
-                    break;
-                }
-            }
+    auto &tokens = participant == Participant::CHARACTER
+                       ? m_character_remaining_tokens
+                       : m_enemy_remaining_tokens;
+    for (auto &token : tokens) {
+        if (damage == 0) {
+            break;
         }
-        for (const auto &token : shields) {
-            erase_token(Participant::CHARACTER, token);
+        if (token.hand == HandFightTokens::SHIELD) {
+            auto harm = std::min(token.count, damage);
+            damage -= harm;
+            token.count -= harm;
         }
+    }
+    std::erase_if(tokens, [](const TokenHandCount &token) {
+        return token.hand == HandFightTokens::SHIELD && token.count == 0;
+    });
+    if (participant == Participant::CHARACTER) {
         if (m_character->get_health() <= damage) {
             m_character->update_health(-m_character->get_health());
             return true;
@@ -32,23 +30,6 @@ bool Fight::make_damage(Participant participant, int damage) {
         m_character->update_health(-damage);
         return false;
     }
-    std::vector<TokenHandCount> shields;
-    for (std::size_t i = 0; i < m_enemy_remaining_tokens.size(); ++i) {
-        if (m_enemy_remaining_tokens[i].hand == HandFightTokens::SHIELD) {
-            auto harm = std::min(m_enemy_remaining_tokens[i].count, damage);
-            damage -= harm;
-            m_enemy_remaining_tokens[i].count -= harm;
-            if (m_enemy_remaining_tokens[i].count == 0) {
-                shields.push_back(m_enemy_remaining_tokens[i]);
-            }
-            if (damage == 0) {
-                break;
-            }
-        }
-    }
-    for (const auto &token : shields) {
-        erase_token(Participant::ENEMY, token);
-    }
     if (m_enemy.get_health() <= damage) {
         m_enemy.update_health(-m_enemy.get_health());
         return true;
@@ -81,33 +62,32 @@ bool Fight::check_combination_tokens(const std::vector<TokenHandCount> &tokens
     return true;
 }
 
-void Fight::shuffle_all_tokens() {
+// Refills the buffers of the remaining tokens in place, so a round does not
+// allocate once the buffers have grown to the numbers of tokens.
+void Fight::shuffle_all_tokens(Random &random) {
     m_character_remaining_tokens.clear();
     m_enemy_remaining_tokens.clear();
-    std::vector<FightToken> enemy_tokens = m_enemy.get_fight_token();
-    std::vector<FightToken> character_tokens =
-        m_character.get()->get_fight_token();
-    for (auto &character_token : character_tokens) {
-        if (rng() % 2 == 0) {
-            m_character_remaining_tokens.push_back(
-                {character_token, character_token.first,
-                 character_token.first_count}
+    for (const auto &character_token : m_character->get_fight_token()) {
+        if (random() % 2 == 0) {
+            m_character_remaining_tokens.emplace_back(
+                character_token, character_token.first,
+                character_token.first_count
             );
         } else {
-            m_character_remaining_tokens.push_back(
-                {character_token, character_token.second,
-                 character_token.second_count}
+            m_character_remaining_tokens.emplace_back(
+                character_token, character_token.second,
+                character_token.second_count
             );
         }
     }
-    for (auto &enemy_token : enemy_tokens) {
-        if (rng() % 2 == 0) {
-            m_enemy_remaining_tokens.push_back(
-                {enemy_token, enemy_token.first, enemy_token.first_count}
+    for (const auto &enemy_token : m_enemy.get_fight_token()) {
+        if (random() % 2 == 0) {
+            m_enemy_remaining_tokens.emplace_back(
+                enemy_token, enemy_token.first, enemy_token.first_count
             );
         } else {
-            m_enemy_remaining_tokens.push_back(
-                {enemy_token, enemy_token.second, enemy_token.second_count}
+            m_enemy_remaining_tokens.emplace_back(
+                enemy_token, enemy_token.second, enemy_token.second_count
             );
         }
     }
@@ -233,7 +213,8 @@ void Fight::make_dexterity(
     runebound::fight::Participant participant,
     const TokenHandCount &token,
     runebound::fight::TokenHandCount dexterity_token,
-    runebound::fight::Participant dexterity_participant
+    runebound::fight::Participant dexterity_participant,
+    Random &random
 ) {
     if (m_turn != participant) {
         throw WrongCharacterTurnException();
@@ -244,11 +225,11 @@ void Fight::make_dexterity(
         if (dexterity_participant == Participant::CHARACTER) {
             reverse_token(Participant::CHARACTER, dexterity_token);
         } else {
-            toss_token(Participant::ENEMY, dexterity_token);
+            toss_token(Participant::ENEMY, dexterity_token, random);
         }
     } else {
         if (dexterity_participant == Participant::CHARACTER) {
-            toss_token(Participant::CHARACTER, dexterity_token);
+            toss_token(Participant::CHARACTER, dexterity_token, random);
         } else {
             reverse_token(Participant::ENEMY, dexterity_token);
         }
@@ -306,12 +287,15 @@ void Fight::make_hit(Participant participant, const TokenHandCount &token) {
     m_enemy.make_hit();
 }
 
-HandFightTokens
-Fight::toss_token(Participant participant, const TokenHandCount &token) {
+HandFightTokens Fight::toss_token(
+    Participant participant,
+    const TokenHandCount &token,
+    Random &random
+) {
     if (participant == Participant::ENEMY) {
         for (auto &enemy_token : m_enemy_remaining_tokens) {
             if (token == enemy_token) {
-                if (rng() % 2 == 0) {
+                if (random() % 2 == 0) {
                     if (enemy_token.hand == enemy_token.token.second) {
                         enemy_token.hand = enemy_token.token.first;
                         enemy_token.count = enemy_token.token.first_count;
@@ -326,7 +310,7 @@ Fight::toss_token(Participant participant, const TokenHandCount &token) {
     }
     for (auto &character_token : m_character_remaining_tokens) {
         if (token == character_token) {
-            if (rng() % 2 == 0) {
+            if (random() % 2 == 0) {
                 if (character_token.hand == character_token.token.second) {
                     character_token.hand = character_token.token.first;
                     character_token.count = character_token.token.first_count;
@@ -372,7 +356,7 @@ Fight::reverse_token(Participant participant, const TokenHandCount &token) {
     return HandFightTokens::NOTHING;
 }
 
-void Fight::start_round() {
+void Fight::start_round(Random &random) {
     m_number_of_rounds += 1;
     if (!m_fight_started) {
         m_fight_started = true;
@@ -384,7 +368,7 @@ void Fight::start_round() {
     }
     m_pass_character = false;
     m_pass_enemy = false;
-    shuffle_all_tokens();
+    shuffle_all_tokens(random);
     unsigned int count_initiatives_character =
         count_initiative(m_character_remaining_tokens);
     unsigned int count_initiatives_enemy =
@@ -0,0 +1,157 @@
+#include "fight_arena.hpp"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fight_policy.hpp"
+
+namespace runebound::fight {
+
+namespace {
+const std::size_t CHUNK_SIZE = 64;
+
+// The duels [begin, end) left to a thread. The owner takes chunks from the
+// front, thieves take the back half.
+struct WorkRange {
+    std::mutex mutex;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+
+    bool pop_chunk(std::size_t &chunk_begin, std::size_t &chunk_end) {
+        std::lock_guard lock(mutex);
+        if (begin == end) {
+            return false;
+        }
+        chunk_begin = begin;
+        chunk_end = std::min(begin + CHUNK_SIZE, end);
+        begin = chunk_end;
+        return true;
+    }
+
+    bool steal_from(WorkRange &victim) {
+        std::size_t stolen_begin = 0;
+        std::size_t stolen_end = 0;
+        {
+            std::lock_guard lock(victim.mutex);
+            if (victim.begin == victim.end) {
+                return false;
+            }
+            stolen_begin = victim.begin + (victim.end - victim.begin) / 2;
+            stolen_end = victim.end;
+            victim.end = stolen_begin;
+        }
+        std::lock_guard lock(mutex);
+        begin = stolen_begin;
+        end = stolen_end;
+        return true;
+    }
+};
+}  // namespace
+
+void ArenaStatistics::add(const DuelResult &result) {
+    ++duels;
+    if (!result.finished) {
+        ++unfinished;
+        return;
+    }
+    if (result.winner == ParticipantTwoPlayers::CALLER) {
+        ++caller_wins;
+    } else {
+        ++receiver_wins;
+    }
+    ++rounds[std::min<std::size_t>(result.rounds, MAX_DUEL_ROUNDS)];
+}
+
+void ArenaStatistics::add(const ArenaStatistics &statistics) {
+    duels += statistics.duels;
+    caller_wins += statistics.caller_wins;
+    receiver_wins += statistics.receiver_wins;
+    unfinished += statistics.unfinished;
+    for (std::size_t i = 0; i < rounds.size(); ++i) {
+        rounds[i] += statistics.rounds[i];
+    }
+}
+
+DuelResult play_duel(
+    const std::shared_ptr<character::Character> &caller,
+    const std::shared_ptr<character::Character> &receiver,
+    Random &random
+) {
+    caller->set_health(caller->get_max_health());
+    receiver->set_health(receiver->get_max_health());
+    FightTwoPlayer fight(caller, receiver);
+    std::vector<TokenHandCount> used;
+    DuelResult result;
+    for (unsigned int round = 1; round <= MAX_DUEL_ROUNDS; ++round) {
+        fight.start_round(random);
+        while (!fight.check_end_fight() && !fight.check_end_round()) {
+            make_policy_move(fight, used);
+        }
+        if (fight.check_end_fight()) {
+            result.finished = true;
+            result.winner = fight.get_winner();
+            result.rounds = round;
+            break;
+        }
+    }
+    return result;
+}
+
+ArenaStatistics run_arena(
+    const character::Character &caller,
+    const character::Character &receiver,
+    std::size_t count_duels,
+    std::uint64_t seed,
+    unsigned int count_threads
+) {
+    count_threads = std::max(1U, count_threads);
+    std::vector<WorkRange> ranges(count_threads);
+    for (unsigned int i = 0; i < count_threads; ++i) {
+        ranges[i].begin = count_duels * i / count_threads;
+        ranges[i].end = count_duels * (i + 1) / count_threads;
+    }
+    std::vector<ArenaStatistics> statistics(count_threads);
+    std::vector<std::thread> threads;
+    for (unsigned int index = 0; index < count_threads; ++index) {
+        threads.emplace_back([&, index]() {
+            // Every thread changes the health of its own copies.
+            auto own_caller = std::make_shared<character::Character>(caller);
+            auto own_receiver =
+                std::make_shared<character::Character>(receiver);
+            auto &range = ranges[index];
+            while (true) {
+                std::size_t chunk_begin = 0;
+                std::size_t chunk_end = 0;
+                if (range.pop_chunk(chunk_begin, chunk_end)) {
+                    for (auto duel = chunk_begin; duel < chunk_end; ++duel) {
+                        Random random(seed + duel);
+                        statistics[index].add(
+                            play_duel(own_caller, own_receiver, random)
+                        );
+                    }
+                    continue;
+                }
+                bool stolen = false;
+                for (unsigned int offset = 1; offset < count_threads && !stolen;
+                     ++offset) {
+                    stolen = range.steal_from(
+                        ranges[(index + offset) % count_threads]
+                    );
+                }
+                if (!stolen) {
+                    break;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ArenaStatistics total;
+    for (const auto &thread_statistics : statistics) {
+        total.add(thread_statistics);
+    }
+    return total;
+}
+
+}  // namespace runebound::fight
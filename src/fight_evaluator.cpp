@@ -0,0 +1,226 @@
+#include "fight_evaluator.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include "fight_policy.hpp"
+
+namespace runebound::fight {
+
+namespace {
+// What the tossed tokens of a side do in a round.
+struct SideOutcome {
+    unsigned int initiative = 0;
+    int damage = 0;
+    int shield = 0;
+    double probability = 0;
+
+    [[nodiscard]] auto get_key() const {
+        return std::tie(initiative, damage, shield);
+    }
+};
+
+// Sorts the outcomes by key and merges the ones with equal keys.
+template <typename Outcome>
+void merge_equal(std::vector<Outcome> &outcomes) {
+    std::sort(
+        outcomes.begin(), outcomes.end(),
+        [](const Outcome &lhs, const Outcome &rhs) {
+            return lhs.get_key() < rhs.get_key();
+        }
+    );
+    std::size_t size = 0;
+    for (const auto &outcome : outcomes) {
+        if (size > 0 && outcomes[size - 1].get_key() == outcome.get_key()) {
+            outcomes[size - 1].probability += outcome.probability;
+        } else {
+            outcomes[size++] = outcome;
+        }
+    }
+    outcomes.resize(size);
+}
+
+// Every side of every token comes up with probability 1/2, so each of the
+// 2^n combinations of sides is equally likely.
+std::vector<SideOutcome> enumerate_sides(const std::vector<FightToken> &tokens
+) {
+    if (tokens.size() > MAX_EVALUATED_TOKENS) {
+        throw TooManyFightTokensException();
+    }
+    const auto count_combinations = 1ULL << tokens.size();
+    const double probability = 1.0 / static_cast<double>(count_combinations);
+    std::vector<SideOutcome> outcomes;
+    outcomes.reserve(count_combinations);
+    std::vector<int> damages;
+    for (unsigned long long sides = 0; sides < count_combinations; ++sides) {
+        SideOutcome outcome;
+        outcome.probability = probability;
+        int count_doublings = 0;
+        damages.clear();
+        for (std::size_t i = 0; i < tokens.size(); ++i) {
+            const auto &token = tokens[i];
+            bool second = (sides >> i) & 1;
+            auto hand = second ? token.second : token.first;
+            auto lead = second ? token.second_lead : token.first_lead;
+            auto count = second ? token.second_count : token.first_count;
+            outcome.initiative += lead;
+            if (is_damage(hand)) {
+                damages.push_back(count);
+            } else if (hand == HandFightTokens::DOUBLING) {
+                ++count_doublings;
+            } else if (hand == HandFightTokens::SHIELD) {
+                outcome.shield += count;
+            }
+        }
+        std::sort(damages.begin(), damages.end(), std::greater<>());
+        for (std::size_t i = 0; i < damages.size(); ++i) {
+            outcome.damage +=
+                damages[i] * (static_cast<int>(i) < count_doublings ? 2 : 1);
+        }
+        outcomes.push_back(outcome);
+    }
+    merge_equal(outcomes);
+    return outcomes;
+}
+}  // namespace
+
+FightEvaluator::FightEvaluator(
+    const std::vector<FightToken> &character_tokens,
+    const std::vector<FightToken> &enemy_tokens
+) {
+    auto character_outcomes = enumerate_sides(character_tokens);
+    auto enemy_outcomes = enumerate_sides(enemy_tokens);
+    for (const auto &character : character_outcomes) {
+        for (const auto &enemy : enemy_outcomes) {
+            RoundOutcome outcome{
+                std::max(0, enemy.damage - character.shield),
+                std::max(0, character.damage - enemy.shield),
+                character.initiative >= enemy.initiative,
+                character.probability * enemy.probability};
+            if (outcome.damage_to_character == 0 &&
+                outcome.damage_to_enemy == 0) {
+                m_draw_probability += outcome.probability;
+            } else {
+                m_outcomes.push_back(outcome);
+            }
+        }
+    }
+    merge_equal(m_outcomes);
+}
+
+FightForecast FightEvaluator::evaluate(int character_health, int enemy_health) {
+    character_health = std::max(character_health, 0);
+    enemy_health = std::max(enemy_health, 0);
+    if (character_health >= m_memo_width || enemy_health >= m_memo_height) {
+        m_memo_width = std::max(m_memo_width, character_health + 1);
+        m_memo_height = std::max(m_memo_height, enemy_health + 1);
+        m_memo.assign(
+            static_cast<std::size_t>(m_memo_width) * m_memo_height,
+            std::nullopt
+        );
+    }
+    return evaluate_memoized(character_health, enemy_health);
+}
+
+// A round either leaves both healths as they are, with the probability of a
+// draw, or lowers at least one of them, so the forecast of a state only
+// depends on the forecasts of states with smaller healths.
+FightForecast
+FightEvaluator::evaluate_memoized(int character_health, int enemy_health) {
+    if (enemy_health == 0) {
+        return {1, 0};
+    }
+    if (character_health == 0) {
+        return {0, 0};
+    }
+    auto index = static_cast<std::size_t>(enemy_health) * m_memo_width +
+                 character_health;
+    if (m_memo[index]) {
+        return *m_memo[index];
+    }
+    FightForecast forecast;
+    double progress_probability = 1 - m_draw_probability;
+    if (m_outcomes.empty()) {
+        forecast.expected_rounds = std::numeric_limits<double>::infinity();
+    } else {
+        double win_probability = 0;
+        double expected_rounds = 1;
+        for (const auto &outcome : m_outcomes) {
+            int next_character_health = character_health;
+            int next_enemy_health = enemy_health;
+            if (outcome.character_first) {
+                next_enemy_health =
+                    std::max(0, enemy_health - outcome.damage_to_enemy);
+                if (next_enemy_health > 0) {
+                    next_character_health = std::max(
+                        0, character_health - outcome.damage_to_character
+                    );
+                }
+            } else {
+                next_character_health =
+                    std::max(0, character_health - outcome.damage_to_character);
+                if (next_character_health > 0) {
+                    next_enemy_health =
+                        std::max(0, enemy_health - outcome.damage_to_enemy);
+                }
+            }
+            auto next =
+                evaluate_memoized(next_character_health, next_enemy_health);
+            win_probability += outcome.probability * next.win_probability;
+            expected_rounds += outcome.probability * next.expected_rounds;
+        }
+        forecast.win_probability = win_probability / progress_probability;
+        forecast.expected_rounds = expected_rounds / progress_probability;
+    }
+    m_memo[index] = forecast;
+    return forecast;
+}
+
+namespace {
+const std::size_t MAX_CACHED_EVALUATORS = 64;
+
+// Evaluators of the recent matchups of the thread, so the sides of the same
+// tokens are enumerated and the same healths are evaluated only once.
+FightEvaluator &get_evaluator(
+    const std::vector<FightToken> &character_tokens,
+    const std::vector<FightToken> &enemy_tokens
+) {
+    struct CachedEvaluator {
+        std::vector<FightToken> character_tokens;
+        std::vector<FightToken> enemy_tokens;
+        FightEvaluator evaluator;
+    };
+
+    thread_local std::vector<CachedEvaluator> cache;
+    for (auto &cached : cache) {
+        if (cached.character_tokens == character_tokens &&
+            cached.enemy_tokens == enemy_tokens) {
+            return cached.evaluator;
+        }
+    }
+    if (cache.size() == MAX_CACHED_EVALUATORS) {
+        cache.clear();
+    }
+    cache.push_back(
+        {character_tokens, enemy_tokens,
+         FightEvaluator(character_tokens, enemy_tokens)}
+    );
+    return cache.back().evaluator;
+}
+}  // namespace
+
+FightForecast evaluate_fight(
+    const ::runebound::character::Character &character,
+    const Enemy &enemy
+) {
+    auto &evaluator =
+        get_evaluator(character.get_fight_token(), enemy.get_fight_token());
+    int enemy_health = enemy.get_health();
+    if (enemy.check_boss()) {
+        enemy_health -= std::min(character.get_knowledge_token(), 7);
+    }
+    return evaluator.evaluate(character.get_health(), enemy_health);
+}
+
+}  // namespace runebound::fight
@@ -29,16 +29,16 @@ void to_json(nlohmann::json &json, const Game &game) {
     json["m_number_of_rounds"] = game.m_number_of_rounds;
     json["m_winner"] = game.m_winner;
     json["m_boss_position"] = game.m_boss_position;
+    json["m_random"] = game.m_random;
     json["m_last_dice_movement_result"] = game.m_last_dice_movement_result;
     json["m_last_dice_relax_result"] = game.m_last_dice_relax_result;
     json["m_last_dice_research_result"] = game.m_last_dice_research_result;
     json["m_last_characteristic_check"] = game.m_last_characteristic_check;
     json["m_last_possible_outcomes"] = game.m_last_possible_outcomes;
-    json["m_all_cards_research"] = game.m_all_cards_research;
-    json["m_all_cards_fight"] = game.m_all_cards_fight;
-    json["m_all_cards_meeting"] = game.m_all_cards_meeting;
+    if (game.m_catalog != Catalog::get_standard()) {
+        to_json(json, *game.m_catalog);
+    }
     json["m_all_skill_cards"] = game.m_all_skill_cards;
-    json["m_all_products"] = game.m_all_products;
     json["m_current_active_card_fight"] = game.m_current_active_card_fight;
     json["m_remaining_standard_characters"] =
         game.m_remaining_standard_characters;
@@ -68,7 +68,7 @@ void fill_vector(const nlohmann::json &json, std::vector<T> &vec) {
 
 void from_json(const nlohmann::json &json, Game &game) {
     game.m_game_over = json["m_game_over"];
-    game.m_map = json["m_map"];
+    from_json(json["m_map"], game.m_map);
     game.m_current_active_card_fight = json["m_current_active_card_fight"];
     game.m_characters.clear();
     for (const auto &character : json["m_characters"]) {
@@ -86,6 +86,11 @@ void from_json(const nlohmann::json &json, Game &game) {
     game.m_number_of_rounds = json["m_number_of_rounds"];
     game.m_winner = json["m_winner"];
     game.m_boss_position = json["m_boss_position"];
+    // Saves made before games had their own generator keep the one the
+    // game was created with.
+    if (json.contains("m_random")) {
+        game.m_random = json["m_random"];
+    }
     fill_vector(
         json["m_last_dice_movement_result"], game.m_last_dice_movement_result
     );
@@ -99,16 +104,15 @@ void from_json(const nlohmann::json &json, Game &game) {
     fill_vector(
         json["m_last_possible_outcomes"], game.m_last_possible_outcomes
     );
-    game.m_all_cards_research.clear();
-    for (const auto &json_card_research : json["m_all_cards_research"]) {
-        cards::CardResearch card;
-        from_json(json_card_research, card, game.m_map);
-        game.m_all_cards_research.push_back(card);
-    }
-    fill_vector(json["m_all_cards_fight"], game.m_all_cards_fight);
-    fill_vector(json["m_all_cards_meeting"], game.m_all_cards_meeting);
+    // Saves made before the catalog was shared carry their own cards.
+    if (json.contains("m_all_cards_research")) {
+        auto catalog = std::make_shared<Catalog>();
+        from_json(json, *catalog, game.m_map);
+        game.m_catalog = std::move(catalog);
+    } else {
+        game.m_catalog = Catalog::get_standard();
+    }
     fill_vector(json["m_all_skill_cards"], game.m_all_skill_cards);
-    fill_vector(json["m_all_products"], game.m_all_products);
     game.m_remaining_standard_characters =
         std::set<character::StandardCharacter>(
             json["m_remaining_standard_characters"].begin(),
@@ -140,6 +144,9 @@ void from_json(const nlohmann::json &json, Game &game) {
     } else {
         game.m_current_fight_two_player = nullptr;
     }
+    for (std::size_t part = 0; part < game.m_part_versions.size(); ++part) {
+        game.mark_changed(static_cast<GamePart>(part));
+    }
 }
 
 Point Game::get_position_character(
@@ -169,6 +176,9 @@ void Game::start_next_character_turn(
     const std::shared_ptr<character::Character> &chr
 ) {
     check_turn(chr);
+    mark_changed(GamePart::TURN);
+    mark_changed(GamePart::CHARACTERS);
+    mark_changed(GamePart::DICE);
     m_last_dice_movement_result.clear();
     m_last_dice_research_result.clear();
     m_last_dice_relax_result.clear();
@@ -184,6 +194,8 @@ void Game::add_bot() {
     if (m_remaining_standard_characters.empty()) {
         throw CharacterAlreadySelected();
     }
+    mark_changed(GamePart::TURN);
+    mark_changed(GamePart::CHARACTERS);
     auto standard_character = *m_remaining_standard_characters.begin();
     m_characters.emplace_back(
         std::make_shared<::runebound::character::Character>(
@@ -204,6 +216,8 @@ std::shared_ptr<::runebound::character::Character> Game::make_character(
     if (m_remaining_standard_characters.count(name) == 0) {
         throw CharacterAlreadySelected();
     }
+    mark_changed(GamePart::TURN);
+    mark_changed(GamePart::CHARACTERS);
     m_characters.emplace_back(
         std::make_shared<::runebound::character::Character>(
             ::runebound::character::Character(name)
@@ -219,84 +233,35 @@ void Game::generate_all_skill_cards() {
     for (int i = 0; i < 100; ++i) {
         m_card_deck_skill[i] = m_all_skill_cards.size();
         m_all_skill_cards.emplace_back(cards::SkillCard(
-            static_cast<bool>(rng() % 2),
-            static_cast<Characteristic>(rng() % 3),
-            static_cast<int>(rng() % 3) + 1
+            static_cast<bool>(m_random() % 2),
+            static_cast<Characteristic>(m_random() % 3),
+            static_cast<int>(m_random() % 3) + 1
         ));
     }
 }
 
-void Game::generate_all_cards_research() {
+void Game::generate_decks() {
     m_card_deck_research.resize(DECK_SIZE);
-    std::string path = "data/json/cards/cards_research";
-    for (const auto &entry : std::filesystem::directory_iterator(path)) {
-        nlohmann::json json;
-        std::ifstream in(entry.path());
-        in >> json;
-        cards::CardResearch card;
-        ::runebound::cards::from_json(json, card, m_map);
-        m_all_cards_research.push_back(card);
-    }
-    for (int i = 0; i < DECK_SIZE; ++i) {
-        m_card_deck_research[i] = i;
-    }
-}
-
-void Game::generate_all_cards_fight() {
     m_card_deck_fight.resize(DECK_SIZE);
-    std::string path = "data/json/cards/cards_fight";
-    for (const auto &entry : std::filesystem::directory_iterator(path)) {
-        nlohmann::json json;
-        std::ifstream in(entry.path());
-        in >> json;
-        cards::CardFight card;
-        ::runebound::cards::from_json(json, card);
-        m_all_cards_fight.push_back(card);
-    }
+    m_card_deck_meeting.resize(DECK_SIZE);
     for (int i = 0; i < DECK_SIZE; ++i) {
+        m_card_deck_research[i] = i;
         m_card_deck_fight[i] = i;
+        m_card_deck_meeting[i] = i;
     }
-}
-
-void Game::generate_all_products() {
-    std::string path = "data/json/products";
-    for (const auto &entry : std::filesystem::directory_iterator(path)) {
-        nlohmann::json json;
-        std::ifstream in(entry.path());
-        in >> json;
-        trade::Product product;
-        ::runebound::trade::from_json(json, product);
-        m_all_products.push_back(product);
-    }
-    m_remaining_products.resize(m_all_products.size());
-    for (std::size_t i = 0; i < m_all_products.size(); ++i) {
+    m_remaining_products.resize(m_catalog->get_count_products());
+    for (std::size_t i = 0; i < m_remaining_products.size(); ++i) {
         m_remaining_products[i] = i;
     }
 }
 
-void Game::generate_all_cards_meeting() {
-    m_card_deck_meeting.resize(DECK_SIZE);
-    std::string path = "data/json/cards/cards_meeting";
-    for (const auto &entry : std::filesystem::directory_iterator(path)) {
-        nlohmann::json json;
-        std::ifstream in(entry.path());
-        in >> json;
-        cards::CardMeeting card;
-        ::runebound::cards::from_json(json, card);
-        m_all_cards_meeting.push_back(card);
-    }
-    for (int i = 0; i < DECK_SIZE; ++i) {
-        m_card_deck_meeting[i] = i;
-    }
-}
-
 void Game::generate_all_shops() {
     auto towns = m_map.get_towns();
     for (const auto &town : towns) {
         m_shops[town] = {};
         for (int i = 0; i < 3; ++i) {
             auto product =
-                m_remaining_products[rng() % m_remaining_products.size()];
+                m_remaining_products[m_random() % m_remaining_products.size()];
             m_shops[town].insert(product);
             m_remaining_products.erase(std::find(
                 m_remaining_products.begin(), m_remaining_products.end(),
@@ -309,6 +274,7 @@ void Game::generate_all_shops() {
 void Game::relax(std::shared_ptr<character::Character> chr) {
     check_turn(chr);
     check_sufficiency_action_points(1);
+    mark_changed(GamePart::CHARACTERS);
     m_characters[m_turn]->relax();
     m_characters[m_turn]->update_action_points(-1);
 }
@@ -323,29 +289,41 @@ void Game::take_token(const std::shared_ptr<character::Character> &chr) {
     if (m_map.get_cell_map(position).get_side_token() == Side::BACK) {
         throw BackSideTokenException();
     }
+    mark_changed(GamePart::CHARACTERS);
+    mark_changed(GamePart::FIGHT);
     if (m_map.get_cell_map(position).get_token() == AdventureType::FIGHT) {
-        unsigned int card = m_card_deck_fight[rng() % m_card_deck_fight.size()];
+        if (m_card_deck_fight.empty()) {
+            throw EmptyDeckException();
+        }
+        unsigned int card =
+            m_card_deck_fight[m_random() % m_card_deck_fight.size()];
         m_current_active_card_fight = card;
         chr->add_card(AdventureType::FIGHT, card);
         m_card_deck_fight.erase(
             std::find(m_card_deck_fight.begin(), m_card_deck_fight.end(), card)
         );
         chr->start_fight(std::make_shared<fight::Fight>(
-            chr, m_all_cards_fight[card].get_enemy()
+            chr, m_catalog->get_card_fight(card).get_enemy()
         ));
         m_current_fight = chr->get_current_fight();
 
         m_characters[get_enemy(m_turn)]->start_fight_as_enemy();
     } else if (m_map.get_cell_map(position).get_token() == AdventureType::RESEARCH) {
+        if (m_card_deck_research.empty()) {
+            throw EmptyDeckException();
+        }
         unsigned int card =
-            m_card_deck_research[rng() % m_card_deck_research.size()];
+            m_card_deck_research[m_random() % m_card_deck_research.size()];
         chr->add_card(AdventureType::RESEARCH, card);
         m_card_deck_research.erase(std::find(
             m_card_deck_research.begin(), m_card_deck_research.end(), card
         ));
     } else if (m_map.get_cell_map(position).get_token() == AdventureType::MEETING) {
+        if (m_card_deck_meeting.empty()) {
+            throw EmptyDeckException();
+        }
         unsigned int card =
-            m_card_deck_meeting[rng() % m_card_deck_meeting.size()];
+            m_card_deck_meeting[m_random() % m_card_deck_meeting.size()];
         chr->add_card(AdventureType::MEETING, card);
         m_card_deck_meeting.erase(std::find(
             m_card_deck_meeting.begin(), m_card_deck_meeting.end(), card
@@ -367,6 +345,9 @@ void Game::end_fight_with_boss(const std::shared_ptr<character::Character> &chr
     if (chr->get_current_fight() == nullptr) {
         throw NoFight();
     }
+    mark_changed(GamePart::TURN);
+    mark_changed(GamePart::CHARACTERS);
+    mark_changed(GamePart::FIGHT);
     if (chr->get_current_fight()->get_winner() ==
         fight::Participant::CHARACTER) {
         m_game_over = true;
@@ -384,10 +365,12 @@ void Game::end_fight(const std::shared_ptr<character::Character> &chr) {
     if (chr->get_current_fight() == nullptr) {
         throw NoFight();
     }
+    mark_changed(GamePart::CHARACTERS);
+    mark_changed(GamePart::FIGHT);
     if (chr->get_current_fight()->get_winner() ==
         fight::Participant::CHARACTER) {
         chr->change_gold(
-            m_all_cards_fight[chr->get_card_fight()].get_gold_award()
+            m_catalog->get_card_fight(chr->get_card_fight()).get_gold_award()
         );
         chr->add_trophy(AdventureType::FIGHT, chr->get_card_fight());
     }
@@ -406,6 +389,7 @@ std::vector<Point> Game::make_move(
     if (m_last_dice_movement_result.empty() &&
         m_map.check_neighbour(m_characters[m_turn]->get_position(), end)) {
         check_sufficiency_action_points(1);
+        mark_changed(GamePart::CHARACTERS);
         m_characters[m_turn]->set_position(end);
         chr->update_action_points(-1);
         return {m_characters[m_turn]->get_position(), end};
@@ -419,6 +403,8 @@ std::vector<Point> Game::make_move(
     if (result.empty()) {
         throw InaccessibleMoveException();
     }
+    mark_changed(GamePart::CHARACTERS);
+    mark_changed(GamePart::DICE);
     m_characters[m_turn]->set_position(end);
     m_last_dice_movement_result.clear();
     return result;
@@ -427,13 +413,12 @@ std::vector<Point> Game::make_move(
 std::vector<std::size_t> Game::get_possible_outcomes(
     const std::shared_ptr<character::Character> &chr
 ) {
+    mark_changed(GamePart::DICE);
     std::vector<std::size_t> outcomes;
-    auto card = chr->get_active_card_research();
-    for (std::size_t i = 0;
-         i < m_all_cards_research[card].get_outcomes().size(); ++i) {
-        if (m_all_cards_research[card].check_outcome(
-                i, m_last_dice_research_result
-            )) {
+    const auto &card =
+        m_catalog->get_card_research(chr->get_active_card_research());
+    for (std::size_t i = 0; i < card.get_outcomes().size(); ++i) {
+        if (card.check_outcome(i, m_last_dice_research_result)) {
             outcomes.push_back(i);
         }
     }
@@ -445,25 +430,25 @@ void Game::complete_card_research(
     const std::shared_ptr<character::Character> &chr,
     int desired_outcome
 ) {
+    mark_changed(GamePart::CHARACTERS);
+    mark_changed(GamePart::DICE);
     auto card = chr->get_active_card_research();
     if (desired_outcome < 0) {
         chr->pop_card(AdventureType::RESEARCH, card);
         m_last_dice_research_result.clear();
         return;
     }
-    if (!m_all_cards_research[card].check_outcome(
+    const auto &card_research = m_catalog->get_card_research(card);
+    if (!card_research.check_outcome(
             desired_outcome, m_last_dice_research_result
         )) {
         throw BadOutcomeException();
     }
     chr->add_trophy(AdventureType::RESEARCH, card);
-    chr->update_health(
-        m_all_cards_research[card].get_delta_health(desired_outcome)
-    );
-    chr->change_gold(m_all_cards_research[card].get_delta_gold(desired_outcome)
-    );
+    chr->update_health(card_research.get_delta_health(desired_outcome));
+    chr->change_gold(card_research.get_delta_gold(desired_outcome));
     chr->change_knowledge_token(
-        m_all_cards_research[card].get_knowledge_token(desired_outcome)
+        card_research.get_knowledge_token(desired_outcome)
     );
     chr->pop_card(AdventureType::RESEARCH, card);
     m_last_dice_research_result.clear();
@@ -476,21 +461,21 @@ bool Game::check_characteristic(
     cards::OptionMeeting option
 ) {
     check_turn(chr);
+    mark_changed(GamePart::CHARACTERS);
+    mark_changed(GamePart::DICE);
     m_last_characteristic_check = false;
+    const auto &card_meeting = m_catalog->get_card_meeting(card);
     int number_attempts =
         chr->get_characteristic(
-            m_all_cards_meeting[card].get_verifiable_characteristic(option)
+            card_meeting.get_verifiable_characteristic(option)
         ) +
-        m_all_cards_meeting[card].get_change_characteristic(option);
+        card_meeting.get_change_characteristic(option);
     chr->pop_card(AdventureType::MEETING, card);
     if (check_characteristic_private(
-            number_attempts,
-            m_all_cards_meeting[card].get_verifiable_characteristic(option)
+            number_attempts, card_meeting.get_verifiable_characteristic(option)
         )) {
-        chr->change_gold(m_all_cards_meeting[card].get_gold_award(option));
-        chr->change_knowledge_token(
-            m_all_cards_meeting[card].get_knowledge_token(option)
-        );
+        chr->change_gold(card_meeting.get_gold_award(option));
+        chr->change_knowledge_token(card_meeting.get_knowledge_token(option));
         chr->add_trophy(AdventureType::MEETING, card);
         m_last_characteristic_check = true;
         return true;
@@ -502,6 +487,8 @@ void Game::start_trade(const std::shared_ptr<character::Character> &chr) {
     check_turn(chr);
     check_town_location(chr);
     check_sufficiency_action_points(1);
+    mark_changed(GamePart::CHARACTERS);
+    mark_changed(GamePart::SHOPS);
     chr->update_action_points(-1);
     add_product_to_shop(chr->get_position());
     chr->start_trade();
@@ -509,6 +496,7 @@ void Game::start_trade(const std::shared_ptr<character::Character> &chr) {
 
 void Game::end_trade(const std::shared_ptr<character::Character> &chr) {
     check_turn(chr);
+    mark_changed(GamePart::CHARACTERS);
     chr->end_trade();
 }
 
@@ -520,16 +508,18 @@ void Game::sell_product_in_town(
     if (!chr->check_product(product)) {
         throw NoProductException();
     }
-    if (m_all_products[product].get_place_of_cell() !=
+    if (m_catalog->get_product(product).get_place_of_cell() !=
         map::SpecialTypeCell::NOTHING) {
         throw NoProductSaleException();
     }
     check_town_location(chr);
-    m_all_products[product].undo_product(chr);
+    mark_changed(GamePart::CHARACTERS);
+    m_catalog->get_product(product).undo_product(chr);
     chr->erase_product(product);
     m_remaining_products.push_back(product);
-    chr->change_gold(static_cast<int>(m_all_products[product].get_market_price()
-    ));
+    chr->change_gold(
+        static_cast<int>(m_catalog->get_product(product).get_market_price())
+    );
 }
 
 void Game::buy_product(
@@ -541,13 +531,17 @@ void Game::buy_product(
     if (m_shops[chr->get_position()].count(product) == 0) {
         throw NoProductException();
     }
-    if (chr->get_gold() < m_all_products[product].get_price()) {
+    if (chr->get_gold() < m_catalog->get_product(product).get_price()) {
         throw NotEnoughGoldException();
     }
+    mark_changed(GamePart::CHARACTERS);
+    mark_changed(GamePart::SHOPS);
     remove_product_from_shop(chr->get_position(), product);
-    m_all_products[product].apply_product(chr);
+    m_catalog->get_product(product).apply_product(chr);
     chr->add_product(product);
-    chr->change_gold(-static_cast<int>(m_all_products[product].get_price()));
+    chr->change_gold(
+        -static_cast<int>(m_catalog->get_product(product).get_price())
+    );
     end_trade(chr);
 }
 
@@ -560,6 +554,7 @@ void Game::discard_product(
     if (m_shops[chr->get_position()].count(product) == 0) {
         throw NoProductException();
     }
+    mark_changed(GamePart::SHOPS);
     remove_product_from_shop(chr->get_position(), product);
     m_remaining_products.push_back(product);
     end_trade(chr);
@@ -573,15 +568,17 @@ void Game::sell_product_in_special_cell(
     if (!chr->check_product(product)) {
         throw NoProductException();
     }
-    if (m_all_products[product].get_place_of_cell() !=
+    if (m_catalog->get_product(product).get_place_of_cell() !=
         m_map.get_cell_map(chr->get_position()).get_special_type_cell()) {
         throw NoProductSaleException();
     }
-    m_all_products[product].undo_product(chr);
+    mark_changed(GamePart::CHARACTERS);
+    m_catalog->get_product(product).undo_product(chr);
     chr->erase_product(product);
     m_remaining_products.push_back(product);
-    chr->change_gold(static_cast<int>(m_all_products[product].get_market_price()
-    ));
+    chr->change_gold(
+        static_cast<int>(m_catalog->get_product(product).get_market_price())
+    );
 }
 
 void Game::start_new_round() {
@@ -619,6 +616,7 @@ void Game::call_to_fight(
 ) {
     check_turn(caller);
     check_sufficiency_action_points(1);
+    mark_changed(GamePart::CHARACTERS);
     receiver->call_to_fight(caller);
     caller->update_action_points(-1);
 }
@@ -628,6 +626,7 @@ void Game::accept_to_fight(const std::shared_ptr<character::Character> &receiver
     if (!receiver->check_caller_to_fight()) {
         throw NotCalledToFight();
     }
+    mark_changed(GamePart::CHARACTERS);
     auto caller = receiver->get_current_caller_to_fight();
     std::shared_ptr<fight::FightTwoPlayer> fight =
         std::make_shared<fight::FightTwoPlayer>(caller, receiver);
@@ -640,35 +639,70 @@ void Game::accept_to_fight(const std::shared_ptr<character::Character> &receiver
 
 void Game::end_fight_two_player(const std::shared_ptr<character::Character> &chr
 ) {
+    mark_changed(GamePart::CHARACTERS);
     auto fight = chr->get_current_fight_two_player();
     fight->get_caller()->end_fight_two_player();
     fight->get_receiver()->end_fight_two_player();
     m_current_fight_two_player = nullptr;
 }
 
-std::vector<Point> Game::get_possible_moves() const {
+void Game::update_possible_moves() const {
+    auto &cache = m_possible_moves;
     if (m_characters.empty()) {
-        return {};
+        cache = PossibleMovesCache();
+        return;
     }
-    auto result = m_map.get_possible_moves(
-        m_characters[m_turn]->get_position(), m_last_dice_movement_result
-    );
+    const auto position = m_characters[m_turn]->get_position();
+    bool valid = cache.valid && cache.position == position &&
+                 cache.dice == m_last_dice_movement_result &&
+                 cache.map_version == m_map.get_version() &&
+                 cache.occupied.size() == m_characters.size();
+    for (std::size_t i = 0; valid && i < m_characters.size(); ++i) {
+        valid = cache.occupied[i] == m_characters[i]->get_position();
+    }
+    if (valid) {
+        return;
+    }
+    cache.valid = true;
+    cache.position = position;
+    cache.dice = m_last_dice_movement_result;
+    cache.map_version = m_map.get_version();
+    cache.occupied.clear();
     for (const auto &character : m_characters) {
-        if (result.count(character->get_position()) > 0) {
-            result.erase(character->get_position());
+        cache.occupied.push_back(character->get_position());
+    }
+    cache.cells =
+        m_map.get_reachable_cells(position, m_last_dice_movement_result);
+    const auto size = m_map.get_size();
+    for (const auto &cell : cache.occupied) {
+        if (cell.x >= 0 && cell.x < size && cell.y >= 0 && cell.y < size) {
+            cache.cells[cell.x * size + cell.y] = false;
         }
     }
-    std::vector<Point> possible_moves;
-    for (const auto &cell : result) {
-        possible_moves.push_back(cell);
+    cache.moves.clear();
+    for (std::size_t cell = 0; cell < cache.cells.size(); ++cell) {
+        if (cache.cells[cell]) {
+            cache.moves.emplace_back(cell / size, cell % size);
+        }
     }
-    return possible_moves;
+}
+
+const std::vector<Point> &Game::get_possible_moves() const {
+    update_possible_moves();
+    return m_possible_moves.moves;
+}
+
+const std::vector<bool> &Game::get_possible_moves_cells() const {
+    update_possible_moves();
+    return m_possible_moves.cells;
 }
 
 void Game::exit_game(const std::shared_ptr<character::Character> &chr) {
     if (m_free_characters.count(chr->get_standard_character()) > 0) {
         throw NotSelectedCharacter();
     }
+    mark_changed(GamePart::TURN);
+    mark_changed(GamePart::CHARACTERS);
     chr->make_new_state_in_game(character::StateCharacterInGame::INACTIVE);
     m_free_characters.insert(chr->get_standard_character());
 }
@@ -677,6 +711,7 @@ void Game::exit_game_and_replace_with_bot(
     const std::shared_ptr<character::Character> &chr
 ) {
     exit_game(chr);
+    mark_changed(GamePart::CHARACTERS);
     chr->make_new_state_in_game(character::StateCharacterInGame::BOT);
 }
 
@@ -684,6 +719,8 @@ void Game::join_game(character::StandardCharacter character) {
     if (m_free_characters.count(character) == 0) {
         throw NotSelectedCharacter();
     }
+    mark_changed(GamePart::TURN);
+    mark_changed(GamePart::CHARACTERS);
     m_free_characters.erase(character);
     get_character_by_standard_characters(character)->make_new_state_in_game(
         character::StateCharacterInGame::PLAYER
@@ -40,7 +40,7 @@ void to_json(nlohmann::json &json, const GameClient &game) {
 }
 
 void from_json(const nlohmann::json &json, GameClient &game) {
-    game.m_map = json["m_map"];
+    from_json(json["m_map"], game.m_map);
     game.m_reward_gold_for_fight = json["m_reward_gold_for_fight"];
     game.m_game_over = json["m_game_over"];
     game.m_turn = json["m_turn"];
@@ -99,4 +99,136 @@ void from_json(const nlohmann::json &json, GameClient &game) {
 
     game.m_winner = json["m_winner"];
 }
-}  // namespace runebound::game
\ No newline at end of file
+
+void GameClientSnapshot::part_to_json(
+    nlohmann::json &json,
+    const Game &game,
+    GamePart part
+) {
+    switch (part) {
+        case GamePart::MAP:
+            json["m_map"] = map::MapClient(game.m_map);
+            break;
+        case GamePart::TURN:
+            json["m_game_over"] = game.m_game_over;
+            json["m_turn"] = game.m_turn;
+            json["m_count_players"] = game.m_count_players;
+            json["m_number_of_rounds"] = game.m_number_of_rounds;
+            json["m_winner"] = game.get_winner();
+            json["m_remaining_standard_characters"] =
+                game.m_remaining_standard_characters;
+            json["m_free_characters"] = game.m_free_characters;
+            break;
+        case GamePart::CHARACTERS:
+            json["m_characters"] = game.get_character_without_shared_ptr();
+            break;
+        case GamePart::DICE:
+            json["m_last_dice_movement_result"] =
+                game.m_last_dice_movement_result;
+            json["m_last_dice_relax_result"] = game.m_last_dice_relax_result;
+            json["m_last_dice_research_result"] =
+                game.m_last_dice_research_result;
+            json["m_last_possible_outcomes"] = game.m_last_possible_outcomes;
+            json["m_last_characteristic_check"] =
+                game.m_last_characteristic_check;
+            break;
+        case GamePart::SHOPS:
+            json["m_shops"] = game.m_shops;
+            break;
+        case GamePart::FIGHT: {
+            json["m_reward_gold_for_fight"] =
+                game.m_current_fight == nullptr
+                    ? 0
+                    : game.m_catalog
+                          ->get_card_fight(game.m_current_active_card_fight)
+                          .get_gold_award();
+            const bool is_fight =
+                !game.m_characters.empty() &&
+                game.m_characters[game.m_turn]->get_current_fight();
+            json["is_fight"] = is_fight;
+            json["m_fight_client"] = nullptr;
+            if (is_fight) {
+                json["m_fight_client"] = fight::FightClient(
+                    *game.m_characters[game.m_turn]->get_current_fight()
+                );
+            }
+            break;
+        }
+        case GamePart::COUNT:
+            break;
+    }
+}
+
+void GameClientSnapshot::update_key(
+    nlohmann::json &patch,
+    const std::string &key,
+    nlohmann::json value
+) {
+    const auto path = "/" + key;
+    if (!m_state.contains(key)) {
+        if (!value.is_null()) {
+            patch.push_back({{"op", "add"}, {"path", path}, {"value", value}});
+            m_state[key] = std::move(value);
+        }
+        return;
+    }
+    if (value.is_null()) {
+        patch.push_back({{"op", "remove"}, {"path", path}});
+        m_state.erase(key);
+        return;
+    }
+    // A diff of a list that shifted, like the possible moves, has an
+    // operation per element and is longer than the list itself.
+    auto diff = nlohmann::json::diff(m_state[key], value, path);
+    if (diff.size() > 1 && diff.dump().size() > value.dump().size()) {
+        patch.push_back({{"op", "replace"}, {"path", path}, {"value", value}});
+    } else {
+        for (auto &operation : diff) {
+            patch.push_back(std::move(operation));
+        }
+    }
+    m_state[key] = std::move(value);
+}
+
+nlohmann::json GameClientSnapshot::update(const Game &game) {
+    auto patch = nlohmann::json::array();
+    if (m_state.is_null()) {
+        m_state = GameClient(game);
+        patch.push_back({{"op", "replace"}, {"path", ""}, {"value", m_state}}
+        );
+    }
+    std::array<bool, static_cast<std::size_t>(GamePart::COUNT)> changed{};
+    for (std::size_t part = 0; part < changed.size(); ++part) {
+        auto version = game.get_part_version(static_cast<GamePart>(part));
+        changed[part] = version != m_part_versions[part];
+        m_part_versions[part] = version;
+    }
+    auto is_changed = [&changed](GamePart part) {
+        return changed[static_cast<std::size_t>(part)];
+    };
+    // Whether the active character fights depends on the turn too.
+    if (is_changed(GamePart::TURN) || is_changed(GamePart::CHARACTERS)) {
+        changed[static_cast<std::size_t>(GamePart::FIGHT)] = true;
+    }
+    if (patch.empty()) {
+        for (std::size_t part = 0; part < changed.size(); ++part) {
+            if (!changed[part]) {
+                continue;
+            }
+            nlohmann::json part_json;
+            part_to_json(part_json, game, static_cast<GamePart>(part));
+            for (auto &item : part_json.items()) {
+                update_key(patch, item.key(), std::move(item.value()));
+            }
+        }
+        if (is_changed(GamePart::MAP) || is_changed(GamePart::TURN) ||
+            is_changed(GamePart::CHARACTERS) || is_changed(GamePart::DICE)) {
+            update_key(patch, "m_possible_moves", game.get_possible_moves());
+        }
+    }
+    if (!patch.empty()) {
+        ++m_version;
+    }
+    return patch;
+}
+}  // namespace runebound::game
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "game_journal.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace runebound::network {
+
+namespace {
+const std::string JOURNAL_EXTENSION = ".journal";
+}  // namespace
+
+GameJournal::GameJournal(
+    std::filesystem::path folder,
+    std::string game_name,
+    unsigned long long sequence
+)
+    : m_folder(std::move(folder)),
+      m_game_name(std::move(game_name)),
+      m_sequence(sequence) {
+}
+
+void GameJournal::append(nlohmann::json entry) {
+    if (!m_file.is_open()) {
+        m_file.open(
+            m_folder / (m_game_name + '.' + std::to_string(m_sequence + 1) +
+                        JOURNAL_EXTENSION),
+            std::ios::app
+        );
+    }
+    entry["sequence"] = ++m_sequence;
+    m_file << entry.dump() << '\n';
+    m_file.flush();
+}
+
+void GameJournal::start_segment() {
+    m_file.close();
+}
+
+void GameJournal::remove_segments_up_to(unsigned long long sequence) const {
+    auto segments = find_segments(m_folder, m_game_name);
+    for (std::size_t i = 0; i + 1 < segments.size(); ++i) {
+        if (segments[i + 1].first > sequence + 1) {
+            break;
+        }
+        std::error_code error;
+        std::filesystem::remove(segments[i].second, error);
+    }
+}
+
+std::vector<std::pair<unsigned long long, std::filesystem::path>>
+GameJournal::find_segments(
+    const std::filesystem::path &folder,
+    const std::string &game_name
+) {
+    std::vector<std::pair<unsigned long long, std::filesystem::path>> segments;
+    for (const auto &entry : std::filesystem::directory_iterator(folder)) {
+        auto file_name = entry.path().filename().string();
+        if (!entry.is_regular_file() ||
+            file_name.size() <= game_name.size() + JOURNAL_EXTENSION.size() ||
+            file_name.compare(0, game_name.size() + 1, game_name + '.') != 0 ||
+            !file_name.ends_with(JOURNAL_EXTENSION)) {
+            continue;
+        }
+        auto number = file_name.substr(
+            game_name.size() + 1,
+            file_name.size() - game_name.size() - 1 - JOURNAL_EXTENSION.size()
+        );
+        if (number.empty() ||
+            !std::all_of(number.begin(), number.end(), [](char symbol) {
+                return std::isdigit(static_cast<unsigned char>(symbol));
+            })) {
+            continue;
+        }
+        segments.emplace_back(std::stoull(number), entry.path());
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+std::vector<nlohmann::json> GameJournal::read(
+    const std::filesystem::path &folder,
+    const std::string &game_name,
+    unsigned long long after_sequence
+) {
+    std::vector<nlohmann::json> entries;
+    for (const auto &segment : find_segments(folder, game_name)) {
+        std::ifstream file(segment.second);
+        std::string line;
+        while (std::getline(file, line)) {
+            auto entry = nlohmann::json::parse(line, nullptr, false);
+            if (entry.is_discarded()) {
+                break;
+            }
+            if (entry["sequence"].get<unsigned long long>() > after_sequence) {
+                entries.push_back(std::move(entry));
+            }
+        }
+    }
+    return entries;
+}
+}  // namespace runebound::network
@@ -0,0 +1,305 @@
+#include "game_simulator.hpp"
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <vector>
+#include "fight_policy.hpp"
+#include "game.hpp"
+
+namespace runebound::simulator {
+
+namespace {
+// Knowledge tokens beyond this do not weaken the boss any more.
+const int MAX_USEFUL_KNOWLEDGE = 7;
+// From this round on the boss marches to Talamir, and the game ends soon.
+const unsigned int BOSS_MARCH_ROUND = 25;
+
+// Returns false if the fight has no winner after MAX_FIGHT_ROUNDS rounds.
+bool play_fight(fight::Fight &fight, Random &random) {
+    std::vector<fight::TokenHandCount> used;
+    for (unsigned int round = 0; round < MAX_FIGHT_ROUNDS; ++round) {
+        fight.start_round(random);
+        while (!fight.check_end_fight() && !fight.check_end_round()) {
+            fight::make_policy_move(fight, used);
+        }
+        if (fight.check_end_fight()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool is_wanted_token(AdventureType token) {
+    return token != AdventureType::NOTHING;
+}
+
+// A character at most half healthy rests instead of fighting.
+bool is_healthy(const character::Character &character) {
+    return character.get_health() * 2 > character.get_max_health();
+}
+
+// The boss is fought with as much knowledge as helps, or when it is about
+// to end the game.
+bool is_ready_for_boss(
+    const game::Game &game,
+    const character::Character &character
+) {
+    return character.get_knowledge_token() >= MAX_USEFUL_KNOWLEDGE ||
+           game.get_number_of_rounds() >= BOSS_MARCH_ROUND;
+}
+
+// The number of steps from every cell to the closest target, whatever the
+// terrain.
+std::vector<int>
+get_distances(const map::Map &map, const std::vector<Point> &targets) {
+    const auto size = map.get_size();
+    std::vector<int> distances(size * size, std::numeric_limits<int>::max());
+    std::queue<Point> queue;
+    for (const auto &target : targets) {
+        distances[target.x * size + target.y] = 0;
+        queue.push(target);
+    }
+    while (!queue.empty()) {
+        auto current = queue.front();
+        queue.pop();
+        for (const auto &next : map.get_neighbours(current)) {
+            auto &distance = distances[next.x * size + next.y];
+            if (distance == std::numeric_limits<int>::max()) {
+                distance = distances[current.x * size + current.y] + 1;
+                queue.push(next);
+            }
+        }
+    }
+    return distances;
+}
+
+// A character ready for the boss goes to it once it is on the map, and a
+// character with research cards goes to their territories: onto a target if
+// it can, otherwise as close as it can. Otherwise a random move to a token,
+// otherwise anywhere.
+Point choose_move(
+    const game::Game &game,
+    const character::Character &character,
+    Random &random
+) {
+    const auto &moves = game.get_possible_moves();
+    const auto map = game.get_map();
+    std::vector<Point> targets;
+    auto boss = game.get_boss_position();
+    if (boss.x >= 0 && is_ready_for_boss(game, character)) {
+        targets.push_back(boss);
+    } else {
+        for (auto card : character.get_cards(AdventureType::RESEARCH)) {
+            auto cells = map.get_territory_cells(
+                game.get_card_research(card).get_required_territory()
+            );
+            targets.insert(targets.end(), cells.begin(), cells.end());
+        }
+    }
+    if (!targets.empty()) {
+        auto distances = get_distances(map, targets);
+        std::vector<Point> closest;
+        int closest_distance = std::numeric_limits<int>::max();
+        for (const auto &move : moves) {
+            auto distance = distances[move.x * map.get_size() + move.y];
+            if (distance < closest_distance) {
+                closest_distance = distance;
+                closest.clear();
+            }
+            if (distance == closest_distance) {
+                closest.push_back(move);
+            }
+        }
+        return closest[random() % closest.size()];
+    }
+    std::vector<Point> tokens;
+    std::vector<Point> research;
+    for (const auto &move : moves) {
+        auto cell = map.get_cell_map(move);
+        if (cell.get_side_token() == Side::FRONT &&
+            is_wanted_token(cell.get_token()) &&
+            cell.get_token() != AdventureType::BOSS) {
+            tokens.push_back(move);
+            if (cell.get_token() == AdventureType::RESEARCH) {
+                research.push_back(move);
+            }
+        }
+    }
+    if (!research.empty()) {
+        return research[random() % research.size()];
+    }
+    const auto &choices = !tokens.empty() ? tokens : moves;
+    return choices[random() % choices.size()];
+}
+
+// Completes a research card of the character if it stands in the territory
+// of the card, with the outcome that gives the most knowledge. Returns false
+// if there is no such card.
+bool play_research(
+    game::Game &game,
+    const std::shared_ptr<character::Character> &character
+) {
+    const auto map = game.get_map();
+    for (auto card : character->get_cards(AdventureType::RESEARCH)) {
+        const auto card_research = game.get_card_research(card);
+        auto cells =
+            map.get_territory_cells(card_research.get_required_territory());
+        if (std::find(cells.begin(), cells.end(), character->get_position()) ==
+            cells.end()) {
+            continue;
+        }
+        game.start_card_execution(character, card, AdventureType::RESEARCH);
+        game.throw_research_dice(character);
+        int best_outcome = -1;
+        for (auto outcome : game.get_possible_outcomes(character)) {
+            auto index = static_cast<int>(outcome);
+            if (best_outcome < 0 ||
+                card_research.get_knowledge_token(index) >
+                    card_research.get_knowledge_token(best_outcome)) {
+                best_outcome = index;
+            }
+        }
+        game.complete_card_research(character, best_outcome);
+        return true;
+    }
+    return false;
+}
+
+// Returns false if a fight got stuck.
+bool play_turn(game::Game &game, Random &random, Statistics &statistics) {
+    auto character = game.get_active_character();
+    if (!is_healthy(*character) && character->get_action_points() > 0) {
+        game.throw_relax_dice(character);
+        game.relax(character);
+    }
+    bool deck_is_empty = false;
+    while (character->get_action_points() > 0 && !game.check_end_game()) {
+        if (play_research(game, character)) {
+            continue;
+        }
+        const auto map = game.get_map();
+        auto cell = map.get_cell_map(character->get_position());
+        auto token = cell.get_token();
+        if (!deck_is_empty && character->get_action_points() >= 2 &&
+            cell.get_side_token() == Side::FRONT && is_wanted_token(token) &&
+            (token != AdventureType::BOSS ||
+             is_ready_for_boss(game, *character))) {
+            try {
+                game.take_token(character);
+            } catch (const game::EmptyDeckException &) {
+                deck_is_empty = true;
+                continue;
+            }
+            if (token == AdventureType::RESEARCH) {
+                continue;
+            }
+            if (token == AdventureType::MEETING) {
+                auto card =
+                    *character->get_cards(AdventureType::MEETING).begin();
+                auto card_meeting = game.get_card_meeting(card);
+                auto option = card_meeting.get_knowledge_token(
+                                  cards::OptionMeeting::SECOND
+                              ) > card_meeting.get_knowledge_token(
+                                      cards::OptionMeeting::FIRST
+                                  )
+                                  ? cards::OptionMeeting::SECOND
+                                  : cards::OptionMeeting::FIRST;
+                game.check_characteristic(character, card, option);
+            } else {
+                if (token == AdventureType::BOSS) {
+                    ++statistics.boss_fights;
+                }
+                if (!play_fight(
+                        *character->get_current_fight(), game.get_random()
+                    )) {
+                    return false;
+                }
+                if (token == AdventureType::BOSS) {
+                    game.end_fight_with_boss(character);
+                } else {
+                    game.end_fight(character);
+                }
+            }
+            continue;
+        }
+        game.throw_movement_dice(character);
+        if (game.get_possible_moves().empty()) {
+            break;
+        }
+        auto move = choose_move(game, *character, random);
+        auto dice = game.get_last_dice_movement_result();
+        game.make_move(character, move, dice);
+        deck_is_empty = false;
+    }
+    if (!game.check_end_game()) {
+        game.start_next_character_turn(character);
+    }
+    return true;
+}
+}  // namespace
+
+void Statistics::add(const Statistics &other) {
+    games += other.games;
+    no_winner += other.no_winner;
+    stalled += other.stalled;
+    failed += other.failed;
+    rounds += other.rounds;
+    boss_fights += other.boss_fights;
+    for (std::size_t i = 0; i < played.size(); ++i) {
+        played[i] += other.played[i];
+        wins[i] += other.wins[i];
+        trophies[i] += other.trophies[i];
+    }
+    if (first_error.empty()) {
+        first_error = other.first_error;
+    }
+}
+
+void play_game(
+    std::uint64_t seed,
+    std::size_t count_players,
+    Statistics &statistics
+) {
+    // The policy has its own generator, so its choices do not change the
+    // dice of the game.
+    Random random(~seed);
+    ++statistics.games;
+    try {
+        game::Game game(seed);
+        auto roster = CHARACTERS;
+        std::shuffle(roster.begin(), roster.end(), random);
+        for (std::size_t i = 0; i < count_players; ++i) {
+            auto character = roster[i].first;
+            game.make_character(character);
+            ++statistics.played[static_cast<std::size_t>(character)];
+        }
+        bool stalled = false;
+        while (!game.check_end_game() && !stalled) {
+            if (game.get_number_of_rounds() >= MAX_ROUNDS ||
+                !play_turn(game, random, statistics)) {
+                stalled = true;
+            }
+        }
+        statistics.rounds += game.get_number_of_rounds();
+        for (const auto &character : game.get_characters()) {
+            statistics.trophies[static_cast<std::size_t>(
+                character->get_standard_character()
+            )] += character->get_trophies().size();
+        }
+        if (stalled) {
+            ++statistics.stalled;
+        } else if (game.get_winner() == character::StandardCharacter::NONE) {
+            ++statistics.no_winner;
+        } else {
+            ++statistics.wins[static_cast<std::size_t>(game.get_winner())];
+        }
+    } catch (const std::exception &e) {
+        ++statistics.failed;
+        if (statistics.first_error.empty()) {
+            statistics.first_error =
+                "game " + std::to_string(seed) + ": " + e.what();
+        }
+    }
+}
+
+}  // namespace runebound::simulator
@@ -1,16 +1,10 @@
-#include <cmath>
+#include <algorithm>
 #include <graphics_board.hpp>
 
-namespace {
-int sign(int x) {
-    return static_cast<int>(x > 0) - static_cast<int>(x < 0);
-}
-}  // namespace
-
 namespace runebound::graphics {
 Board::Board(const ::runebound::map::MapClient &map) {
-    for (int row = 0; row < ::runebound::map::STANDARD_SIZE; ++row) {
-        for (int col = 0; col < ::runebound::map::STANDARD_SIZE; ++col) {
+    for (int row = 0; row < map.get_size(); ++row) {
+        for (int col = 0; col < map.get_size(); ++col) {
             add_cell(map, row, col);
             add_special(map, row, col);
             add_token(map, row, col);
@@ -21,17 +15,27 @@ Board::Board(const ::runebound::map::MapClient &map) {
 }
 
 void Board::add_rivers(const map::MapClient &map) {
-    for (const auto &pair : map.m_rivers) {
-        const SDL_Color river_color = {55, 26, 250, 255};
-        const auto [x1, y1] = pair.first;
-        const auto [x2, y2] = pair.second;
-        const auto [i, v] = *RIVER_DIRECTIONS.find(
-            {sign(x1 - x2) + (1 - std::abs(sign(x1 - x2))) * (2 * (y1 % 2) - 1),
-             sign(y1 - y2)}
+    const SDL_Color river_color = {55, 26, 250, 255};
+    const int size = map.get_size();
+    const auto neighbour_table = map::get_neighbour_table(size);
+    for (const auto &[lhs, rhs] : map.m_rivers) {
+        const int cell = lhs.x * size + lhs.y;
+        const auto &neighbours = neighbour_table[cell];
+        const auto direction = static_cast<std::size_t>(
+            std::find(
+                neighbours.begin(), neighbours.end(), rhs.x * size + rhs.y
+            ) -
+            neighbours.begin()
         );
-        const HexagonShape hex =
-            m_cells[x1 * ::runebound::map::STANDARD_SIZE + y1];
-        const Segment seg = {hex.get_vertex(v.first), hex.get_vertex(v.second)};
+        if (direction == map::COUNT_DIRECTIONS) {
+            continue;
+        }
+        // The side towards the neighbour in direction d joins the vertices
+        // d and d + 1 of the hexagon.
+        const HexagonShape hex = m_cells[cell];
+        const Segment seg = {
+            hex.get_vertex(direction),
+            hex.get_vertex((direction + 1) % map::COUNT_DIRECTIONS)};
         add_river(seg, river_color);
     }
 }
@@ -44,8 +48,10 @@ void Board::add_river(const Segment &segment, SDL_Color color) {
 
 void Board::add_cell(const ::runebound::map::MapClient &map, int row, int col) {
     const auto center = get_center_of_hexagon(row, col);
+    const auto type_cell =
+        map.get_cell_map(::runebound::Point(row, col)).get_type_cell();
     const auto [type_cell_key, cell_fill_color] =
-        *CELL_FILL_COLOR.find(map.m_map[row][col].get_type_cell());
+        *CELL_FILL_COLOR.find(type_cell);
     m_cells.emplace_back(center, HEXAGON_RADIUS);
     m_cell_fill_color.push_back(cell_fill_color);
     m_cell_border_color.push_back({0, 0, 0, 255});
@@ -60,7 +66,7 @@ void Board::add_token(
     int col
 ) {
     const auto center = get_center_of_hexagon(row, col);
-    const auto cell = map.m_map[row][col];
+    const auto cell = map.get_cell_map(::runebound::Point(row, col));
     if (cell.get_token() != ::runebound::AdventureType::NOTHING) {
         SDL_Color color;
         if (cell.get_side_token() == ::runebound::Side::FRONT) {
@@ -80,7 +86,8 @@ void Board::add_special(
     int row,
     int col
 ) {
-    const auto special = map.m_map[row][col].get_special_type_cell();
+    const auto special =
+        map.get_cell_map(::runebound::Point(row, col)).get_special_type_cell();
     if (special != ::runebound::map::SpecialTypeCell::NOTHING) {
         const auto center = get_center_of_hexagon(row, col);
         const auto [special_type_cell_key, img] = *SPECIAL_TO_STR.find(special);
@@ -91,19 +98,19 @@ void Board::add_special(
 }
 
 void Board::add_road(const ::runebound::map::MapClient &map, int row, int col) {
-    if (map.m_map[row][col].check_road()) {
+    if (map.get_cell_map(::runebound::Point(row, col)).check_road()) {
         const auto center = get_center_of_hexagon(row, col);
         for (auto [i, j] :
              map.get_all_neighbours(::runebound::Point(row, col))) {
-            if (map.m_map[i][j].check_road() ||
-                map.m_map[i][j].get_type_cell() ==
-                    ::runebound::map::TypeCell::TOWN) {
+            const auto neighbour = map.get_cell_map(::runebound::Point(i, j));
+            if (neighbour.check_road() ||
+                neighbour.get_type_cell() == ::runebound::map::TypeCell::TOWN) {
                 const Segment seg(center, get_center_of_hexagon(i, j));
                 m_roads.push_back(seg);
                 m_road_color.push_back({0x80, 0x80, 0x80, 0xFF});
                 ++m_road_amount;
                 m_is_connected_to_town.push_back(
-                    map.m_map[i][j].get_type_cell() ==
+                    neighbour.get_type_cell() ==
                     ::runebound::map::TypeCell::TOWN
                 );
             }
@@ -56,7 +56,4 @@ const std::map<::runebound::map::SpecialTypeCell, std::string> SPECIAL_TO_STR =
      {::runebound::map::SpecialTypeCell::FORTRESS, "Fortress"},
      {::runebound::map::SpecialTypeCell::SETTLEMENT, "Settlement"},
      {::runebound::map::SpecialTypeCell::NOTHING, ""}};
-const std::map<std::pair<int, int>, std::pair<int, int>> RIVER_DIRECTIONS = {
-    {{-1, 0}, {3, 4}}, {{-1, -1}, {2, 3}}, {{-1, 1}, {4, 5}},
-    {{1, 0}, {0, 1}},  {{1, -1}, {1, 2}},  {{1, 1}, {5, 0}}};
 }  // namespace runebound::graphics
\ No newline at end of file
@@ -352,8 +352,8 @@ void Client::update_game_window() {
         window->remove_button("trade");
         const auto *me = m_network_client.get_yourself_character();
         const auto &pos = me->get_position();
-        const auto &cell =
-            m_network_client.get_game_client().m_map.m_map[pos.x][pos.y];
+        const auto cell =
+            m_network_client.get_game_client().m_map.get_cell_map(pos);
         if (cell.get_type_cell() == ::runebound::map::TypeCell::TOWN) {
             Texture texture;
             texture.load_text_from_string(
@@ -380,8 +380,8 @@ void Client::update_game_window() {
             ::runebound::character::StandardCharacter::NONE) {
             const auto *me = m_network_client.get_yourself_character();
             const auto &pos = me->get_position();
-            const auto &cell =
-                m_network_client.get_game_client().m_map.m_map[pos.x][pos.y];
+            const auto cell =
+                m_network_client.get_game_client().m_map.get_cell_map(pos);
 
             if (cell.get_token() != ::runebound::AdventureType::NOTHING) {
                 Texture texture;
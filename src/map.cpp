@@ -1,5 +1,7 @@
 #include "map.hpp"
 #include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <nlohmann/json.hpp>
@@ -9,16 +11,8 @@
 namespace runebound {
 namespace map {
 
-const std::vector<Point> &Map::get_directions(const Point &point) const {
-    if (point.y % 2 == 0) {
-        return directions_even_column;
-    }
-    return directions_odd_column;
-}
-
 bool Map::check_neighbour(const Point &lhs, const Point &rhs) const {
-    auto directions = get_directions(lhs);
-    for (const auto &direction : directions) {
+    for (const auto &direction : get_directions(lhs)) {
         if (lhs + direction == rhs) {
             return true;
         }
@@ -26,51 +20,169 @@ bool Map::check_neighbour(const Point &lhs, const Point &rhs) const {
     return false;
 }
 
+Map::Map(
+    int size,
+    const std::vector<std::vector<MapCell>> &map,
+    std::set<std::pair<Point, Point>> rivers,
+    std::map<std::string, std::vector<Point>> territory_name
+)
+    : m_map(std::make_shared<MapGrid>(map)),
+      m_size(size),
+      m_version(make_version()) {
+    auto layout = std::make_shared<MapLayout>();
+    layout->river_directions = index_rivers(rivers);
+    layout->rivers = std::move(rivers);
+    layout->towns = find_towns();
+    layout->territory_name = std::move(territory_name);
+    m_layout = std::move(layout);
+}
+
+const Map &Map::get_standard() {
+    static const Map map = []() {
+        nlohmann::json json;
+        std::ifstream in("data/json/map/map.json");
+        in >> json;
+        return Map(json);
+    }();
+    return map;
+}
+
+unsigned long long Map::make_version() {
+    static std::atomic<unsigned long long> last_version = 0;
+    return ++last_version;
+}
+
+MapGrid &Map::get_grid_for_change() {
+    if (m_map.use_count() > 1) {
+        m_map = std::make_shared<MapGrid>(*m_map);
+    }
+    m_version = make_version();
+    return *m_map;
+}
+
+std::vector<std::uint8_t> Map::index_rivers(
+    const std::set<std::pair<Point, Point>> &rivers
+) const {
+    std::vector<std::uint8_t> river_directions(m_size * m_size, 0);
+    for (const auto &[lhs, rhs] : rivers) {
+        const auto &directions = get_directions(lhs);
+        for (int direction = 0; direction < COUNT_DIRECTIONS; ++direction) {
+            if (lhs + directions[direction] == rhs) {
+                river_directions[m_map->get_index(lhs)] |= 1 << direction;
+            }
+        }
+    }
+    return river_directions;
+}
+
+std::set<Point> Map::find_towns() const {
+    std::set<Point> towns;
+    for (int row = 0; row < m_size; ++row) {
+        for (int column = 0; column < m_size; ++column) {
+            if (get_cell_map(Point(row, column)).get_type_cell() ==
+                TypeCell::TOWN) {
+                towns.insert(Point(row, column));
+            }
+        }
+    }
+    return towns;
+}
+
+bool Map::check_river(const Point &lhs_point, const Point &rhs_point) const {
+    const auto &directions = get_directions(lhs_point);
+    for (int direction = 0; direction < COUNT_DIRECTIONS; ++direction) {
+        if (lhs_point + directions[direction] == rhs_point) {
+            return check_river_in_direction(lhs_point, direction);
+        }
+    }
+    return false;
+}
+
+bool Map::check_step(
+    std::size_t current,
+    std::size_t next,
+    int direction,
+    ::runebound::dice::TerrainMask terrains
+) const {
+    auto next_cell = m_map->get_cell(next);
+    if (next_cell.check_road()) {
+        return true;
+    }
+    // Crossing a river takes a die that enters water.
+    auto type = (m_layout->river_directions[current] >> direction) & 1
+                    ? TypeCell::WATER
+                    : next_cell.get_type_cell();
+    return (terrains & ::runebound::dice::get_terrain_bit(type)) != 0;
+}
+
+// Breadth-first search over (cell, set of spent dice) states. Each step spends
+// exactly one die, so the spent set describes the rest of the move completely
+// and a single pass replaces trying every order of the dice. Dice with equal
+// faces are interchangeable, so only the first unspent one of each face is
+// tried. If reachable is not null, every reached cell is collected and the
+// search does not stop at end.
 std::vector<Point> Map::make_move(
     const Point &start,
     const Point &end,
-    const std::vector<::runebound::dice::HandDice> &dice_roll_results,
-    int count_dice
+    std::vector<::runebound::dice::HandDice> dice_roll_results,
+    std::vector<bool> *reachable
 ) const {
-    std::map<Point, int> dist;
-    std::map<Point, Point> parent;
-    dist[start] = 0;
-    std::queue<Point> bfs_queue;
-    bfs_queue.push(start);
-    parent[start] = Point(-1, -1);
-    while (!bfs_queue.empty()) {
-        auto current = bfs_queue.front();
-        bfs_queue.pop();
-        if (dist[current] > count_dice) {
-            return {};
-        }
-        if (current == end) {
+    std::sort(dice_roll_results.begin(), dice_roll_results.end());
+    const int count_dice = static_cast<int>(dice_roll_results.size());
+    const int count_masks = 1 << count_dice;
+    std::vector<::runebound::dice::TerrainMask> terrains(count_dice);
+    std::transform(
+        dice_roll_results.begin(), dice_roll_results.end(), terrains.begin(),
+        ::runebound::dice::get_terrain_mask
+    );
+    const auto neighbour_table = get_neighbour_table(m_size);
+    auto state_of = [&](const Point &cell, int mask) {
+        return (cell.x * m_size + cell.y) * count_masks + mask;
+    };
+    auto cell_of = [&](int state) {
+        int cell = state / count_masks;
+        return Point(cell / m_size, cell % m_size);
+    };
+    const int not_visited = -2;
+    std::vector<int> parent(m_size * m_size * count_masks, not_visited);
+    std::vector<int> bfs_queue;
+    parent[state_of(start, 0)] = -1;
+    bfs_queue.push_back(state_of(start, 0));
+    for (std::size_t head = 0; head < bfs_queue.size(); ++head) {
+        int state = bfs_queue[head];
+        int mask = state % count_masks;
+        int cell = state / count_masks;
+        if (reachable != nullptr) {
+            (*reachable)[cell] = true;
+        } else if (cell_of(state) == end) {
             std::vector<Point> result;
-            while (current != Point(-1, -1)) {
-                result.push_back(current);
-                current = parent[current];
+            while (state != -1) {
+                result.push_back(cell_of(state));
+                state = parent[state];
             }
             std::reverse(result.begin(), result.end());
             return result;
         }
-        for (const auto &direction : get_directions(current)) {
-            if (check_neighbour_in_direction(current, direction)) {
-                auto new_point = get_neighbour_in_direction(current, direction);
-                if (!dist.count(new_point) &&
-                    ((get_cell_map(new_point).check_road() ||
-                      (!check_river(current, new_point) &&
-                       ::runebound::dice::check_hand_dice(
-                           get_cell_map(new_point).get_type_cell(),
-                           dice_roll_results[dist[current]]
-                       ))) ||
-                     (check_river(current, new_point) &&
-                      (dice_roll_results[dist[current]] ==
-                           ::runebound::dice::HandDice::JOKER ||
-                       dice_roll_results[dist[current]] ==
-                           ::runebound::dice::HandDice::MOUNTAINS_WATER)))) {
-                    dist[new_point] = dist[current] + 1;
-                    parent[new_point] = current;
-                    bfs_queue.push(new_point);
+        for (int dice = 0; dice < count_dice; ++dice) {
+            if ((mask >> dice) & 1) {
+                continue;
+            }
+            if (dice > 0 &&
+                dice_roll_results[dice] == dice_roll_results[dice - 1] &&
+                !((mask >> (dice - 1)) & 1)) {
+                continue;
+            }
+            const auto &neighbours = neighbour_table[cell];
+            for (int direction = 0; direction < COUNT_DIRECTIONS; ++direction) {
+                int next = neighbours[direction];
+                if (next == NO_NEIGHBOUR) {
+                    continue;
+                }
+                int new_state = next * count_masks + (mask | (1 << dice));
+                if (parent[new_state] == not_visited &&
+                    check_step(cell, next, direction, terrains[dice])) {
+                    parent[new_state] = state;
+                    bfs_queue.push_back(new_state);
                 }
             }
         }
@@ -86,44 +198,35 @@ std::vector<Point> Map::check_move(
     if (check_neighbour(start, end)) {
         return {start, end};
     }
-    std::sort(dice_roll_results.begin(), dice_roll_results.end());
-    do {
-        auto result = make_move(
-            start, end, dice_roll_results,
-            static_cast<int>(dice_roll_results.size())
-        );
-        if (!result.empty()) {
-            return result;
-        }
-
-    } while (std::next_permutation(
-        dice_roll_results.begin(), dice_roll_results.end()
-    ));
-    return {};
+    return make_move(start, end, std::move(dice_roll_results), nullptr);
 }
 
 void to_json(nlohmann::json &json, const Map &map) {
-    json["m_map"] = map.m_map;
+    json["m_map"] = *map.m_map;
     json["m_size"] = map.m_size;
-    json["m_rivers"] = map.m_rivers;
-    json["m_towns"] = map.m_towns;
-    json["m_territory_name"] = map.m_territory_name;
+    json["m_rivers"] = map.m_layout->rivers;
+    json["m_towns"] = map.m_layout->towns;
+    json["m_territory_name"] = map.m_layout->territory_name;
 }
 
 void from_json(const nlohmann::json &json, Map &map) {
-    map.m_map = json["m_map"];
-    map.m_rivers = json["m_rivers"];
-    map.m_towns = json["m_towns"];
+    map.m_map = std::make_shared<MapGrid>(json["m_map"].get<MapGrid>());
     map.m_size = json["m_size"];
-    map.m_territory_name = json["m_territory_name"];
+    map.m_version = Map::make_version();
+    auto layout = std::make_shared<MapLayout>();
+    layout->rivers = json["m_rivers"];
+    layout->river_directions = map.index_rivers(layout->rivers);
+    layout->towns = json["m_towns"];
+    layout->territory_name = json["m_territory_name"];
+    map.m_layout = std::move(layout);
 }
 
 std::vector<Point> Map::get_neighbours(Point current) const {
-    auto directions = get_directions(current);
     std::vector<Point> result;
-    for (const auto &direction : directions) {
-        if (check_neighbour_in_direction(current, direction)) {
-            result.push_back(get_neighbour_in_direction(current, direction));
+    result.reserve(COUNT_DIRECTIONS);
+    for (auto next : get_neighbour_table(m_size)[m_map->get_index(current)]) {
+        if (next != NO_NEIGHBOUR) {
+            result.emplace_back(next / m_size, next % m_size);
         }
     }
     return result;
@@ -133,65 +236,34 @@ std::set<Point> Map::get_possible_moves(
     Point start,
     std::vector<::runebound::dice::HandDice> dice_roll_results
 ) const {
-    if (dice_roll_results.empty()) {
-        auto neighbours = get_neighbours(start);
-        std::set<Point> result(neighbours.begin(), neighbours.end());
-        return result;
-    }
-    std::sort(dice_roll_results.begin(), dice_roll_results.end());
+    auto cells = get_reachable_cells(start, std::move(dice_roll_results));
     std::set<Point> result;
-    auto neighbours = get_neighbours(start);
-    for (const auto &neighbour : neighbours) {
-        result.insert(neighbour);
-    }
-    do {
-        std::map<Point, unsigned int> dist;
-        dist[start] = 0;
-        std::queue<Point> bfs_queue;
-        bfs_queue.push(start);
-        while (!bfs_queue.empty()) {
-            auto current = bfs_queue.front();
-            bfs_queue.pop();
-            if (dist[current] >
-                static_cast<unsigned int>(dice_roll_results.size())) {
-                break;
-            }
-            for (const auto &direction : get_directions(current)) {
-                if (check_neighbour_in_direction(current, direction)) {
-                    auto new_point =
-                        get_neighbour_in_direction(current, direction);
-                    if (!dist.count(new_point) &&
-                        ((get_cell_map(new_point).check_road() ||
-                          (!check_river(current, new_point) &&
-                           ::runebound::dice::check_hand_dice(
-                               get_cell_map(new_point).get_type_cell(),
-                               dice_roll_results[dist[current]]
-                           ))) ||
-                         (check_river(current, new_point) &&
-                          (dice_roll_results[dist[current]] ==
-                               ::runebound::dice::HandDice::JOKER ||
-                           dice_roll_results[dist[current]] ==
-                               ::runebound::dice::HandDice::MOUNTAINS_WATER))
-                        )) {
-                        if (dist[current] + 1 <=
-                            static_cast<unsigned int>(dice_roll_results.size()
-                            )) {
-                            dist[new_point] = dist[current] + 1;
-                            bfs_queue.push(new_point);
-                        }
-                    }
-                }
-            }
-        }
-        for (const auto &move : dist) {
-            result.insert(move.first);
+    for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+        if (cells[cell]) {
+            result.insert(Point(cell / m_size, cell % m_size));
         }
-
-    } while (std::next_permutation(
-        dice_roll_results.begin(), dice_roll_results.end()
-    ));
+    }
     return result;
 }
 
+std::vector<bool> Map::get_reachable_cells(
+    Point start,
+    std::vector<::runebound::dice::HandDice> dice_roll_results
+) const {
+    std::vector<bool> cells(m_size * m_size);
+    for (auto next : get_neighbour_table(m_size)[m_map->get_index(start)]) {
+        if (next != NO_NEIGHBOUR) {
+            cells[next] = true;
+        }
+    }
+    if (!dice_roll_results.empty()) {
+        // Only the reachable cells are wanted here, not the path.
+        static_cast<void>(
+            make_move(start, start, std::move(dice_roll_results), &cells)
+        );
+    }
+    return cells;
+}
+
 }  // namespace map
 }  // namespace runebound
@@ -3,27 +3,12 @@
 
 namespace runebound::map {
 
-bool MapClient::check_neighbour_in_direction(
-    const Point &cell,
-    const Point &direction
-) const {
-    return (cell.x + direction.x >= 0) && (cell.x + direction.x < m_size) &&
-           (cell.y + direction.y >= 0) && (cell.y + direction.y < m_size);
-}
-
 std::vector<Point> MapClient::get_all_neighbours(const Point &cell) const {
-    std::vector<Point> directions;
-    if (cell.y % 2 == 0) {
-        directions = directions_even_column;
-    } else {
-        directions = directions_odd_column;
-    }
     std::vector<Point> neighbours;
-    for (auto direction : directions) {
-        if (check_neighbour_in_direction(cell, direction)) {
-            neighbours.emplace_back(
-                Point(cell.x + direction.x, cell.y + direction.y)
-            );
+    neighbours.reserve(COUNT_DIRECTIONS);
+    for (auto next : get_neighbour_table(m_size)[m_map.get_index(cell)]) {
+        if (next != NO_NEIGHBOUR) {
+            neighbours.emplace_back(next / m_size, next % m_size);
         }
     }
     return neighbours;
@@ -56,7 +41,7 @@ const std::set<std::pair<Point, Point>> &MapClient::get_rivers() const {
     return m_rivers;
 }
 
-const std::vector<std::vector<MapCell>> &MapClient::get_map() const {
+const MapGrid &MapClient::get_map() const {
     return m_map;
 }
 
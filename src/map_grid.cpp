@@ -0,0 +1,124 @@
+#include "map_grid.hpp"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+namespace runebound::map {
+
+MapGrid::MapGrid(const std::vector<std::vector<MapCell>> &map) {
+    resize(static_cast<int>(map.size()));
+    for (int row = 0; row < m_size; ++row) {
+        for (int column = 0; column < m_size; ++column) {
+            set_cell(get_index(Point(row, column)), map[row][column]);
+        }
+    }
+}
+
+void MapGrid::resize(int size) {
+    m_size = size;
+    const auto count_cells = static_cast<std::size_t>(size * size);
+    m_type_cell.assign(count_cells, 0);
+    m_special_type_cell.assign(
+        count_cells, static_cast<std::uint8_t>(SpecialTypeCell::NOTHING)
+    );
+    m_road.assign(count_cells, 0);
+    m_token.assign(
+        count_cells, static_cast<std::uint8_t>(AdventureType::NOTHING)
+    );
+    m_side_token.assign(count_cells, static_cast<std::uint8_t>(Side::FRONT));
+    m_territory.assign(count_cells, 0);
+    m_territory_names = {""};
+}
+
+void MapGrid::set_cell(std::size_t index, const MapCell &cell) {
+    m_type_cell[index] = static_cast<std::uint8_t>(cell.get_type_cell());
+    m_special_type_cell[index] =
+        static_cast<std::uint8_t>(cell.get_special_type_cell());
+    m_road[index] = static_cast<std::uint8_t>(cell.check_road());
+    m_token[index] = static_cast<std::uint8_t>(cell.get_token());
+    m_side_token[index] = static_cast<std::uint8_t>(cell.get_side_token());
+    m_territory[index] = intern_territory_name(cell.get_territory_name());
+}
+
+std::uint8_t MapGrid::intern_territory_name(const std::string &name) {
+    auto it =
+        std::find(m_territory_names.begin(), m_territory_names.end(), name);
+    if (it != m_territory_names.end()) {
+        return static_cast<std::uint8_t>(it - m_territory_names.begin());
+    }
+    if (m_territory_names.size() > UINT8_MAX) {
+        throw TooManyTerritoriesException();
+    }
+    m_territory_names.push_back(name);
+    return static_cast<std::uint8_t>(m_territory_names.size() - 1);
+}
+
+std::vector<std::vector<MapCell>> MapGrid::get_cells() const {
+    std::vector<std::vector<MapCell>> cells(
+        m_size, std::vector<MapCell>(m_size)
+    );
+    for (int row = 0; row < m_size; ++row) {
+        for (int column = 0; column < m_size; ++column) {
+            cells[row][column] = get_cell(Point(row, column)).to_map_cell();
+        }
+    }
+    return cells;
+}
+
+MapCell MapCellView::to_map_cell() const {
+    MapCell cell(get_type_cell());
+    cell.make_special_type_cell(get_special_type_cell());
+    if (check_road()) {
+        cell.make_road();
+    }
+    cell.make_name_territory(get_territory_name());
+    cell.make_token(get_token());
+    if (get_side_token() == Side::BACK) {
+        cell.reverse_token();
+    }
+    return cell;
+}
+
+void to_json(nlohmann::json &json, const MapGrid &grid) {
+    json = nlohmann::json::array();
+    for (int row = 0; row < grid.m_size; ++row) {
+        nlohmann::json json_row = nlohmann::json::array();
+        for (int column = 0; column < grid.m_size; ++column) {
+            auto cell = grid.get_cell(Point(row, column));
+            nlohmann::json json_cell;
+            json_cell["m_type_cell"] = cell.get_type_cell();
+            json_cell["m_token"] = cell.get_token();
+            json_cell["m_side_token"] = cell.get_side_token();
+            json_cell["m_special_type_cell"] = cell.get_special_type_cell();
+            json_cell["m_road"] = cell.check_road();
+            json_cell["m_territory_name"] = cell.get_territory_name();
+            json_row.push_back(std::move(json_cell));
+        }
+        json.push_back(std::move(json_row));
+    }
+}
+
+void from_json(const nlohmann::json &json, MapGrid &grid) {
+    grid.resize(static_cast<int>(json.size()));
+    for (int row = 0; row < grid.m_size; ++row) {
+        for (int column = 0; column < grid.m_size; ++column) {
+            const auto &json_cell = json[row][column];
+            auto index = grid.get_index(Point(row, column));
+            grid.m_type_cell[index] =
+                static_cast<std::uint8_t>(json_cell["m_type_cell"].get<int>());
+            grid.m_token[index] =
+                static_cast<std::uint8_t>(json_cell["m_token"].get<int>());
+            grid.m_side_token[index] =
+                static_cast<std::uint8_t>(json_cell["m_side_token"].get<int>());
+            grid.m_special_type_cell[index] = static_cast<std::uint8_t>(
+                json_cell["m_special_type_cell"].get<int>()
+            );
+            grid.m_road[index] =
+                static_cast<std::uint8_t>(json_cell["m_road"].get<bool>());
+            grid.m_territory[index] = grid.intern_territory_name(
+                json_cell["m_territory_name"].get<std::string>()
+            );
+        }
+    }
+}
+
+}  // namespace runebound::map
@@ -0,0 +1,29 @@
+#include "map_neighbours.hpp"
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace runebound::map {
+
+std::span<const Neighbours> get_neighbour_table(int size) {
+    if (size == STANDARD_SIZE) {
+        return STANDARD_NEIGHBOUR_TABLE;
+    }
+    static std::mutex mutex;
+    static std::map<int, std::vector<Neighbours>> tables;
+    std::lock_guard lock(mutex);
+    auto [it, inserted] = tables.try_emplace(size);
+    if (inserted) {
+        it->second.reserve(size * size);
+        for (int row = 0; row < size; ++row) {
+            for (int column = 0; column < size; ++column) {
+                it->second.push_back(
+                    get_cell_neighbours(size, Point(row, column))
+                );
+            }
+        }
+    }
+    return it->second;
+}
+
+}  // namespace runebound::map
@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "network_client.hpp"
+
+// Plays many games on a running network_server over loopback and measures
+// it. Every game gets up to six simulated players; the active one plays
+// like the bot: it throws the movement dice, moves to a random cell of the
+// possible moves and passes when it has no action points left. The latency
+// of an action is the time from sending it to the first game message or
+// exception received after it. Nobody acts before every player of the game
+// has selected a character, so the only messages of a game are then the
+// answers to its active player.
+//
+// Usage: network_loadgen [players] [games] [seconds] [threads] [server pid]
+
+using Clock = std::chrono::steady_clock;
+using runebound::character::StandardCharacter;
+
+namespace {
+const int COUNT_CHARACTERS = 6;
+const auto SETUP_TIME = std::chrono::seconds(3);
+
+struct Player {
+    std::unique_ptr<runebound::network::Client> client;
+    std::string game_name;
+    StandardCharacter character = StandardCharacter::NONE;
+    std::size_t count_game_players = 0;
+    bool joined = false;
+    bool waiting = false;
+    Clock::time_point sent_at;
+};
+
+// Everything a thread of the generator owns. It is touched only from the
+// thread running its io_context until the thread is joined.
+struct Worker {
+    boost::asio::io_context io_context;
+    std::vector<Player> players;
+    std::mt19937 random{std::random_device{}()};
+    bool measuring = false;
+    std::vector<long long> latencies;
+    std::size_t actions = 0;
+    std::size_t errors = 0;
+    // Bytes of all clients when measuring started, and the bytes they
+    // received and sent until it stopped.
+    std::size_t start_received_bytes = 0;
+    std::size_t start_sent_bytes = 0;
+    std::size_t received_bytes = 0;
+    std::size_t sent_bytes = 0;
+
+    [[nodiscard]] std::size_t get_received_bytes() const {
+        std::size_t bytes = 0;
+        for (const auto &player : players) {
+            bytes += player.client->get_received_bytes();
+        }
+        return bytes;
+    }
+
+    [[nodiscard]] std::size_t get_sent_bytes() const {
+        std::size_t bytes = 0;
+        for (const auto &player : players) {
+            bytes += player.client->get_sent_bytes();
+        }
+        return bytes;
+    }
+
+    void start_measuring() {
+        start_received_bytes = get_received_bytes();
+        start_sent_bytes = get_sent_bytes();
+        measuring = true;
+    }
+
+    void stop_measuring() {
+        received_bytes = get_received_bytes() - start_received_bytes;
+        sent_bytes = get_sent_bytes() - start_sent_bytes;
+        measuring = false;
+    }
+};
+
+void act(Worker &worker, Player &player) {
+    auto &client = *player.client;
+    const auto &game = client.get_game_client();
+    if (client.m_character != player.character ||
+        game.m_characters.size() != player.count_game_players ||
+        game.m_game_over ||
+        game.m_characters[game.m_turn].get_standard_character() !=
+            player.character) {
+        return;
+    }
+    const auto &character = game.m_characters[game.m_turn];
+    if (!game.m_last_dice_movement_result.empty() &&
+        !game.m_possible_moves.empty()) {
+        const auto &move = game.m_possible_moves
+            [worker.random() % game.m_possible_moves.size()];
+        client.make_move(move.x, move.y);
+    } else if (character.get_action_points() > 0 &&
+               game.m_last_dice_movement_result.empty()) {
+        client.throw_move_dice();
+    } else {
+        client.pass();
+    }
+    player.waiting = true;
+    player.sent_at = Clock::now();
+}
+
+void on_message(Worker &worker, Player &player, const json &answer) {
+    auto &client = *player.client;
+    if (!player.joined) {
+        const auto &names = client.get_game_names();
+        if (std::find(names.begin(), names.end(), player.game_name) !=
+            names.end()) {
+            client.join_game(player.game_name);
+            client.select_character(player.character);
+            player.joined = true;
+        }
+        return;
+    }
+    const auto &type = answer["change type"];
+    if (player.waiting &&
+        (type == "game" || type == "game patch" || type == "exception")) {
+        player.waiting = false;
+        if (worker.measuring) {
+            worker.latencies.push_back(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    Clock::now() - player.sent_at
+                )
+                    .count()
+            );
+            ++worker.actions;
+            worker.errors += type == "exception";
+        }
+    }
+    if (!player.waiting) {
+        act(worker, player);
+    }
+}
+
+std::string read_rss(const std::string &pid) {
+    std::ifstream status("/proc/" + pid + "/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            return line.substr(6);
+        }
+    }
+    return " unknown";
+}
+
+long long get_percentile(const std::vector<long long> &sorted, double part) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    auto index = static_cast<std::size_t>(part * (sorted.size() - 1));
+    return sorted[index];
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    try {
+        int count_players = argc > 1 ? std::stoi(argv[1]) : 1000;
+        int count_games = std::max(1, argc > 2 ? std::stoi(argv[2]) : 200);
+        int seconds = argc > 3 ? std::stoi(argv[3]) : 10;
+        int count_threads =
+            std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        if (argc > 4) {
+            count_threads = std::max(1, std::stoi(argv[4]));
+        }
+        std::string server_pid = argc > 5 ? argv[5] : "";
+        count_players = std::min(count_players, count_games * COUNT_CHARACTERS);
+
+        // Clients are not thread-safe, so each thread runs its own
+        // io_context with its own players.
+        std::vector<std::unique_ptr<Worker>> workers;
+        for (int i = 0; i < count_threads; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        auto prefix = "loadgen-" +
+                      std::to_string(Clock::now().time_since_epoch().count());
+        for (int i = 0; i < count_players; ++i) {
+            auto &worker = *workers[i % count_threads];
+            auto &player = worker.players.emplace_back();
+            player.game_name = prefix + "-" + std::to_string(i % count_games);
+            player.character =
+                static_cast<StandardCharacter>(i / count_games + 1);
+            player.count_game_players =
+                count_players / count_games +
+                (i % count_games < count_players % count_games ? 1 : 0);
+            player.client = std::make_unique<runebound::network::Client>(
+                worker.io_context, "127.0.0.1", 4444,
+                "player" + std::to_string(i)
+            );
+        }
+        for (auto &worker : workers) {
+            for (std::size_t i = 0; i < worker->players.size(); ++i) {
+                auto &player = worker->players[i];
+                player.client->set_message_handler(
+                    [&worker = *worker, &player](const json &answer) {
+                        on_message(worker, player, answer);
+                    }
+                );
+                if (player.character == StandardCharacter::LISSA) {
+                    player.client->add_game(player.game_name);
+                }
+            }
+        }
+
+        std::vector<std::thread> threads;
+        for (auto &worker : workers) {
+            threads.emplace_back([&io_context = worker->io_context]() {
+                auto guard = boost::asio::make_work_guard(io_context);
+                io_context.run();
+            });
+        }
+        std::this_thread::sleep_for(SETUP_TIME);
+        for (auto &worker : workers) {
+            boost::asio::post(worker->io_context, [&worker = *worker]() {
+                worker.start_measuring();
+            });
+        }
+        auto start = Clock::now();
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        for (auto &worker : workers) {
+            boost::asio::post(worker->io_context, [&worker = *worker]() {
+                worker.stop_measuring();
+                worker.io_context.stop();
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        double elapsed =
+            std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::vector<long long> latencies;
+        std::size_t actions = 0;
+        std::size_t errors = 0;
+        std::size_t received_bytes = 0;
+        std::size_t sent_bytes = 0;
+        std::size_t waiting_players = 0;
+        for (const auto &worker : workers) {
+            latencies.insert(
+                latencies.end(), worker->latencies.begin(),
+                worker->latencies.end()
+            );
+            actions += worker->actions;
+            errors += worker->errors;
+            received_bytes += worker->received_bytes;
+            sent_bytes += worker->sent_bytes;
+            for (const auto &player : worker->players) {
+                waiting_players += player.waiting;
+            }
+        }
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << "players: " << count_players << '\n'
+                  << "games: " << count_games << '\n'
+                  << "actions: " << actions << '\n'
+                  << "errors: " << errors << '\n'
+                  << "actions in flight: " << waiting_players << '\n'
+                  << "actions/s: " << actions / elapsed << '\n'
+                  << "latency p50 us: " << get_percentile(latencies, 0.5)
+                  << '\n'
+                  << "latency p99 us: " << get_percentile(latencies, 0.99)
+                  << '\n'
+                  << "latency p999 us: " << get_percentile(latencies, 0.999)
+                  << '\n'
+                  << "received bytes/action: "
+                  << (actions == 0 ? 0 : received_bytes / actions) << '\n'
+                  << "sent bytes/action: "
+                  << (actions == 0 ? 0 : sent_bytes / actions) << '\n';
+        if (!server_pid.empty()) {
+            std::cout << "server rss:" << read_rss(server_pid) << '\n';
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
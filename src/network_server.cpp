@@ -2,10 +2,14 @@
 #include <boost/asio.hpp>
 #include <chrono>
 #include <deque>
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <set>
 #include <thread>
@@ -14,6 +18,7 @@
 #include "fight.hpp"
 #include "game.hpp"
 #include "game_client.hpp"
+#include "save_service.hpp"
 
 // #define NETWORK_DEBUG_INFO
 
@@ -22,373 +27,613 @@ using json = nlohmann::json;
 
 class Connection;
 
+// Guards the registry of games and connections below; games themselves are
+// guarded by the strands of their rooms.
+std::mutex registry_mutex;
 std::vector<std::string> game_names;
-std::set<Connection *> connections;
-std::map<std::string, runebound::game::Game> games;
-std::map<std::string, std::set<std::string>> game_users;
-std::map<std::string, std::shared_ptr<runebound::character::Character>>
-    user_character;
-std::map<std::string, Connection *> user_connection;
-int counter = 0;
-
-void save_game(const std::string &game_name) {
+std::map<std::string, std::shared_ptr<GameRoom>> rooms;
+std::set<std::weak_ptr<Connection>, std::owner_less<>> connections;
+std::atomic<int> counter = 0;
+std::chrono::milliseconds bot_think_time =
+    runebound::bot::Bot::DEFAULT_THINK_TIME;
+std::chrono::milliseconds save_interval(1000);
+const std::filesystem::path save_folder = "save";
+std::unique_ptr<runebound::network::SaveService> save_service;
+
+// Actions that change a game; they are played through GameRoom::play.
+const std::set<std::string> GAME_ACTIONS = {
+    "take token", "exit_game", "exit_game_and_replace_with_bot",
+    "select character", "select free character", "throw move dice",
+    "make move", "pass", "relax", "fight", "trade", "adventure", "add_bot"};
+
+std::shared_ptr<GameRoom> find_room(const std::string &game_name) {
+    std::lock_guard lock(registry_mutex);
+    auto it = rooms.find(game_name);
+    return it == rooms.end() ? nullptr : it->second;
+}
+
+// The snapshot remembers the last journaled action it includes. Journal
+// segments before it are removed once the snapshot is on disk.
+void save_game(GameRoom &room) {
     json data;
-    runebound::game::Game game;
-    to_json(data, games[game_name]);
-    data["game_name"] = game_name;
-    std::ofstream file("save/" + game_name + ".json");
-    file << data;
-    file.close();
+    to_json(data, room.game);
+    data["game_name"] = room.name;
+    auto sequence = room.journal.get_sequence();
+    data["journal_sequence"] = sequence;
+    room.journal.start_segment();
+    save_service->save(
+        room.name, data.dump(),
+        [room = room.shared_from_this(), sequence]() {
+            boost::asio::post(room->strand, [room, sequence]() {
+                room->journal.remove_segments_up_to(sequence);
+            });
+        }
+    );
+}
+
+// Must be called on the strand of the room. The game is serialized at most
+// once per save interval, however many actions were made meanwhile.
+void schedule_save(GameRoom &room) {
+    if (room.save_scheduled) {
+        return;
+    }
+    room.save_scheduled = true;
+    room.save_timer.expires_after(save_interval);
+    room.save_timer.async_wait([room = room.shared_from_this()](
+                                   boost::system::error_code ec
+                               ) {
+        if (ec == boost::asio::error::operation_aborted) {
+            return;
+        }
+        room->save_scheduled = false;
+        save_game(*room);
+    });
 }
 
 void Connection::start() {
     std::cout << "Some connected\n";
-    connections.insert(this);
-    do_read();
-    send_game_names();
+    {
+        std::lock_guard lock(registry_mutex);
+        connections.insert(weak_from_this());
+    }
+    boost::asio::dispatch(
+        socket_.get_executor(),
+        [this, self = shared_from_this()]() {
+            do_read();
+            send_game_names();
+        }
+    );
 }
 
-void Connection::write(const std::string &message) {
+void Connection::disconnect() {
+    {
+        std::lock_guard lock(registry_mutex);
+        connections.erase(weak_from_this());
+    }
+    std::cout << "Disconnected" << std::endl;
+}
+
+Connection::Message Connection::make_message(const json &data) {
+    return std::make_shared<const runebound::network::OutgoingMessage>(data);
+}
+
+void Connection::write(Message message) {
+    boost::asio::dispatch(
+        socket_.get_executor(),
+        [this, self = shared_from_this(), message = std::move(message)]() {
+            queue_message(message);
+        }
+    );
+}
+
+void Connection::queue_message(Message message) {
+    const auto &frame = message->get_frame(m_write_format);
+    if (m_write_queue_bytes + frame.size() > MAX_WRITE_QUEUE_BYTES) {
+        std::cerr << "Write queue overflow, closing connection" << std::endl;
+        boost::system::error_code ec;
+        socket_.close(ec);
+        return;
+    }
+    m_write_queue_bytes += frame.size();
+    m_write_queue.emplace_back(std::move(message), &frame);
+    if (!m_write_in_progress) {
+        do_write();
+    }
+}
+
+void Connection::do_write() {
+    // Everything queued so far goes out in one gather write; messages queued
+    // meanwhile wait for the next one, so the order is kept.
+    m_write_in_progress = true;
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.reserve(m_write_queue.size());
+    for (const auto &[message, frame] : m_write_queue) {
+        buffers.push_back(boost::asio::buffer(*frame));
+    }
     auto self(shared_from_this());
     boost::asio::async_write(
-        socket_, boost::asio::buffer(message + '\n'),
-        [this, self,
-         message](boost::system::error_code ec, std::size_t length) {
-            if (!ec) {
+        socket_, buffers,
+        [this, self, count_messages = buffers.size()](
+            boost::system::error_code ec, [[maybe_unused]] std::size_t length
+        ) {
+            if (ec) {
+                std::cerr << "Write failed: " << ec.message() << std::endl;
+                m_write_queue.clear();
+                m_write_queue_bytes = 0;
+                m_write_in_progress = false;
+                disconnect();
+                return;
+            }
 #ifdef NETWORK_DEBUG_INFO
-                std::cout << "Sent:" << message.substr(0, 80) << ' ' << length
-                          << std::endl;
+            std::cout << "Sent: " << count_messages << " messages, " << length
+                      << " bytes" << std::endl;
 #endif
+            for (std::size_t i = 0; i < count_messages; ++i) {
+                m_write_queue_bytes -= m_write_queue.front().second->size();
+                m_write_queue.pop_front();
+            }
+            if (!m_write_queue.empty()) {
+                do_write();
             } else {
-                std::cerr << "Write failed: " << ec.message() << std::endl;
-                connections.erase(this);
-                std::cout << "Disconnected" << std::endl;
+                m_write_in_progress = false;
             }
         }
     );
 }
 
-void Connection::parse_message(std::string &message) {
-    try {
-        json data = json::parse(message);
+void Connection::set_wire_format(const json &data) {
+    auto format =
+        runebound::network::wire_format_from_string(data["wire format"]);
+    // The client writes in the new format right after the request, and
+    // reads in it after this answer, which still goes in the old format.
+    m_read_format = format;
+    json answer;
+    answer["change type"] = "wire format";
+    answer["wire format"] = runebound::network::to_string(format);
+    queue_message(make_message(answer));
+    m_write_format = format;
+}
 
-        if (data["action type"] == "take token") {
-            m_game->take_token(user_character[m_user_name]);
-            send_game_for_all();
+void Connection::parse_message(const std::string &frame) {
+    json data;
+    try {
+        data = runebound::network::decode_message(frame, m_read_format);
+        if (data["action type"] == "set wire format") {
+            set_wire_format(data);
+            do_read();
+            return;
         }
-        if (data["action type"] == "add game") {
-            std::string game_name = data["game name"];
-            if (std::find(game_names.begin(), game_names.end(), game_name) !=
-                game_names.end()) {
-                throw std::runtime_error("Game is already existing");
-            }
-            game_names.push_back(game_name);
-            games[game_name] = runebound::game::Game();
-
-            for (auto session : connections) {
-                session->send_game_names();
+        if (data["action type"] == "join game") {
+            auto room = find_room(data["game name"]);
+            if (room == nullptr) {
+                throw std::runtime_error("Game does not exist");
             }
-            save_game(game_name);
+            leave_room();
+            m_room = std::move(room);
+            m_game = &m_room->game;
+        }
+    } catch (std::exception &e) {
+        send_exception(e.what());
+        do_read();
+        return;
+    }
+    if (m_room == nullptr) {
+        handle_action(data);
+        do_read();
+        return;
+    }
+    boost::asio::post(
+        m_room->strand,
+        [this, self = shared_from_this(), data = std::move(data)]() mutable {
+            handle_action(data);
+            boost::asio::post(socket_.get_executor(), [this, self]() {
+                do_read();
+            });
         }
+    );
+}
 
-        if (data["action type"] == "join game") {
-            m_game_name = data["game name"];
-            m_user_name = data["user name"];
-            m_user_name += std::to_string(counter++);
+void Connection::leave_room() {
+    if (m_room == nullptr) {
+        return;
+    }
+    boost::asio::post(m_room->strand, [room = m_room, user = m_user_name]() {
+        room->users.erase(user);
+    });
+    m_room = nullptr;
+    m_game = nullptr;
+}
 
-            m_game = &games[m_game_name];
-            user_connection[m_user_name] = this;
-            game_users[m_game_name].insert(m_user_name);
+void Connection::send_exception(const std::string &what) {
+    std::cout << what << '\n';
+    json answer;
+    answer["change type"] = "exception";
+    answer["exception"] = what;
+    write(make_message(answer));
+}
 
-            send_game_for_all();
-        }
+void apply_action(
+    runebound::game::Game &game,
+    const std::shared_ptr<runebound::character::Character> &character,
+    json &data
+) {
+    if (data["action type"] == "take token") {
+        game.take_token(character);
+    }
 
-        if (data["action type"] == "exit_game") {
-            m_game->exit_game(user_character[m_user_name]);
-            game_users[m_game_name].erase(m_user_name);
-            send_game_for_all();
-            user_character[m_user_name] = nullptr;
-            m_game = nullptr;
-            m_game_name = "";
-            send_selected_character(
-                runebound::character::StandardCharacter::NONE
-            );
-        }
+    if (data["action type"] == "exit_game") {
+        game.exit_game(character);
+    }
 
-        if (data["action type"] == "exit_game_and_replace_with_bot") {
-            m_game->exit_game_and_replace_with_bot(user_character[m_user_name]);
-            game_users[m_game_name].erase(m_user_name);
-            send_game_for_all();
-            user_character[m_user_name] = nullptr;
-            m_game = nullptr;
-            m_game_name = "";
-            send_selected_character(
-                runebound::character::StandardCharacter::NONE
-            );
-        }
+    if (data["action type"] == "exit_game_and_replace_with_bot") {
+        game.exit_game_and_replace_with_bot(character);
+    }
 
-        if (data["action type"] == "select character") {
-            runebound::character::StandardCharacter character =
-                data["character"];
-            m_game->make_character(character);
-            user_character[m_user_name] = m_game->get_character(character);
-            send_game_for_all();
-            send_selected_character(character);
-        }
+    if (data["action type"] == "select character") {
+        game.make_character(
+            data["character"].get<runebound::character::StandardCharacter>()
+        );
+    }
 
-        if (data["action type"] == "select free character") {
-            runebound::character::StandardCharacter character =
-                data["character"];
-            m_game->join_game(character);
-            user_character[m_user_name] = m_game->get_character(character);
-            send_game_for_all();
-            send_selected_character(character);
-        }
+    if (data["action type"] == "select free character") {
+        game.join_game(
+            data["character"].get<runebound::character::StandardCharacter>()
+        );
+    }
 
-        if (data["action type"] == "throw move dice") {
-            m_game->throw_movement_dice(user_character[m_user_name]);
-            send_game_for_all();
-        }
-        if (data["action type"] == "make move") {
-            int x = data["x"], y = data["y"];
-            auto dice = m_game->get_last_dice_movement_result();
-            auto path =
-                m_game->make_move(user_character[m_user_name], {x, y}, dice);
-            send_game_for_all();
-        }
+    if (data["action type"] == "throw move dice") {
+        game.throw_movement_dice(character);
+    }
+    if (data["action type"] == "make move") {
+        int x = data["x"], y = data["y"];
+        auto dice = game.get_last_dice_movement_result();
+        auto path = game.make_move(character, {x, y}, dice);
+    }
 
-        if (data["action type"] == "pass") {
-            m_game->start_next_character_turn(user_character[m_user_name]);
-            send_game_for_all();
-            while (m_game->get_active_character()->get_state_in_game() ==
-                   runebound::character::StateCharacterInGame::BOT) {
-                play_as_bot();
-            }
-        }
+    if (data["action type"] == "pass") {
+        game.start_next_character_turn(character);
+    }
 
-        if (data["action type"] == "relax") {
-            m_game->throw_relax_dice(user_character[m_user_name]);
-            m_game->relax(user_character[m_user_name]);
-            send_game_for_all();
-        }
+    if (data["action type"] == "relax") {
+        game.throw_relax_dice(character);
+        game.relax(character);
+    }
 
-        if (data["action type"] == "fight") {
-            if (data["fight command"] == "end fight") {
-                if (m_game->get_current_fight()->get_enemy()->check_boss()) {
-                    m_game->end_fight_with_boss(user_character[m_user_name]);
-                } else {
-                    m_game->end_fight(user_character[m_user_name]);
-                }
+    if (data["action type"] == "fight") {
+        // Fight commands change the fight and the health of the character
+        // through the fight itself, so the game does not see them.
+        game.mark_changed(runebound::game::GamePart::FIGHT);
+        game.mark_changed(runebound::game::GamePart::CHARACTERS);
+        if (data["fight command"] == "end fight") {
+            if (game.get_current_fight()->get_enemy()->check_boss()) {
+                game.end_fight_with_boss(character);
+            } else {
+                game.end_fight(character);
             }
+        }
 
-            if (data["fight command"] == "use tokens") {
-                if (data["token type"] == "undefined") {
-                    // std::cout << data.dump() << "\n";
-                    std::vector<runebound::fight::TokenHandCount> tokens_me =
-                        data["tokens_me"];
-                    std::vector<runebound::fight::TokenHandCount> tokens_enemy =
-                        data["tokens_enemy"];
-                    runebound::fight::Participant participant_me =
-                        data["participant"];
-                    runebound::fight::Participant participant_enemy =
-                        (participant_me ==
-                         runebound::fight::Participant::CHARACTER)
-                            ? runebound::fight::Participant::ENEMY
-                            : runebound::fight::Participant::CHARACTER;
-                    if (tokens_me.empty()) {
-                        throw std::runtime_error("0 size");
-                    }
-
-                    bool is_checked = false;
+        if (data["fight command"] == "use tokens") {
+            if (data["token type"] == "undefined") {
+                // std::cout << data.dump() << "\n";
+                std::vector<runebound::fight::TokenHandCount> tokens_me =
+                    data["tokens_me"];
+                std::vector<runebound::fight::TokenHandCount> tokens_enemy =
+                    data["tokens_enemy"];
+                runebound::fight::Participant participant_me =
+                    data["participant"];
+                runebound::fight::Participant participant_enemy =
+                    (participant_me ==
+                     runebound::fight::Participant::CHARACTER)
+                        ? runebound::fight::Participant::ENEMY
+                        : runebound::fight::Participant::CHARACTER;
+                if (tokens_me.empty()) {
+                    throw std::runtime_error("0 size");
+                }
 
-                    // Dexterity
-                    for (auto token : tokens_me) {
-                        if (token.hand ==
-                            runebound::fight::HandFightTokens::DEXTERITY) {
-                            is_checked = true;
-                            if ((tokens_enemy.size() == 1) &&
-                                (tokens_me.size() == 1)) {
-                                m_game->get_current_fight()->make_dexterity(
-                                    participant_me, tokens_me[0],
-                                    tokens_enemy[0], participant_enemy
-                                );
-                            } else {
-                                if ((tokens_enemy.empty()) &&
-                                    (tokens_me.size() == 2)) {
-                                    if (tokens_me[0].hand ==
-                                        runebound::fight::HandFightTokens::
-                                            DEXTERITY) {
-                                        m_game->get_current_fight()
-                                            ->make_dexterity(
-                                                participant_me, tokens_me[0],
-                                                tokens_me[1], participant_me
-                                            );
-                                    } else {
-                                        m_game->get_current_fight()
-                                            ->make_dexterity(
-                                                participant_me, tokens_me[1],
-                                                tokens_me[0], participant_me
-                                            );
-                                    }
+                bool is_checked = false;
+
+                // Dexterity
+                for (auto token : tokens_me) {
+                    if (token.hand ==
+                        runebound::fight::HandFightTokens::DEXTERITY) {
+                        is_checked = true;
+                        if ((tokens_enemy.size() == 1) &&
+                            (tokens_me.size() == 1)) {
+                            game.get_current_fight()->make_dexterity(
+                                participant_me, tokens_me[0], tokens_enemy[0],
+                                participant_enemy, game.get_random()
+                            );
+                        } else {
+                            if ((tokens_enemy.empty()) &&
+                                (tokens_me.size() == 2)) {
+                                if (tokens_me[0].hand ==
+                                    runebound::fight::HandFightTokens::
+                                        DEXTERITY) {
+                                    game.get_current_fight()->make_dexterity(
+                                        participant_me, tokens_me[0],
+                                        tokens_me[1], participant_me,
+                                        game.get_random()
+                                    );
                                 } else {
-                                    throw std::runtime_error("Wrong dexterity");
+                                    game.get_current_fight()->make_dexterity(
+                                        participant_me, tokens_me[1],
+                                        tokens_me[0], participant_me,
+                                        game.get_random()
+                                    );
                                 }
+                            } else {
+                                throw std::runtime_error("Wrong dexterity");
                             }
                         }
                     }
-                    // Doubling
-                    if (!is_checked) {
-                        for (auto token : tokens_me) {
-                            if (token.hand ==
-                                runebound::fight::HandFightTokens::DOUBLING) {
-                                is_checked = true;
-                                if ((tokens_enemy.empty()) &&
-                                    (tokens_me.size() == 2)) {
-                                    if (tokens_me[0].hand ==
-                                        runebound::fight::HandFightTokens::
-                                            DOUBLING) {
-                                        m_game->get_current_fight()
-                                            ->make_doubling(
-                                                participant_me, tokens_me[0],
-                                                tokens_me[1]
-                                            );
-                                    } else {
-                                        m_game->get_current_fight()
-                                            ->make_doubling(
-                                                participant_me, tokens_me[1],
-                                                tokens_me[0]
-                                            );
-                                    }
+                }
+                // Doubling
+                if (!is_checked) {
+                    for (auto token : tokens_me) {
+                        if (token.hand ==
+                            runebound::fight::HandFightTokens::DOUBLING) {
+                            is_checked = true;
+                            if ((tokens_enemy.empty()) &&
+                                (tokens_me.size() == 2)) {
+                                if (tokens_me[0].hand ==
+                                    runebound::fight::HandFightTokens::
+                                        DOUBLING) {
+                                    game.get_current_fight()->make_doubling(
+                                        participant_me, tokens_me[0],
+                                        tokens_me[1]
+                                    );
                                 } else {
-                                    throw std::runtime_error("Wrong doubling");
+                                    game.get_current_fight()->make_doubling(
+                                        participant_me, tokens_me[1],
+                                        tokens_me[0]
+                                    );
                                 }
+                            } else {
+                                throw std::runtime_error("Wrong doubling");
                             }
                         }
                     }
-                    // Damage
-                    if (!is_checked) {
-                        if ((tokens_enemy.empty()) &&
-                            (tokens_me[0].hand ==
-                                 runebound::fight::HandFightTokens::
-                                     ENEMY_DAMAGE ||
-                             tokens_me[0].hand ==
-                                 runebound::fight::HandFightTokens::
-                                     MAGICAL_DAMAGE ||
-                             tokens_me[0].hand ==
-                                 runebound::fight::HandFightTokens::
-                                     PHYSICAL_DAMAGE)) {
-                            is_checked = true;
-                            m_game->get_current_fight()->make_damage(
-                                participant_me, tokens_me
-                            );
-                        } else {
-                            throw std::runtime_error("Wrong damage");
-                        }
+                }
+                // Damage
+                if (!is_checked) {
+                    if ((tokens_enemy.empty()) &&
+                        (tokens_me[0].hand ==
+                             runebound::fight::HandFightTokens::ENEMY_DAMAGE ||
+                         tokens_me[0].hand ==
+                             runebound::fight::HandFightTokens::
+                                 MAGICAL_DAMAGE ||
+                         tokens_me[0].hand ==
+                             runebound::fight::HandFightTokens::
+                                 PHYSICAL_DAMAGE)) {
+                        is_checked = true;
+                        game.get_current_fight()->make_damage(
+                            participant_me, tokens_me
+                        );
+                    } else {
+                        throw std::runtime_error("Wrong damage");
                     }
                 }
             }
-            if (data["fight command"] == "fight_pass") {
+        }
+        if (data["fight command"] == "fight_pass") {
+            if (data["participant"] ==
+                runebound::fight::Participant::CHARACTER) {
+                game.get_current_fight()->pass_character();
+            } else {
                 if (data["participant"] ==
-                    runebound::fight::Participant::CHARACTER) {
-                    m_game->get_current_fight()->pass_character();
-                } else {
-                    if (data["participant"] ==
-                        runebound::fight::Participant::ENEMY) {
-                        m_game->get_current_fight()->pass_enemy();
-                    }
+                    runebound::fight::Participant::ENEMY) {
+                    game.get_current_fight()->pass_enemy();
                 }
             }
-            send_game_for_all();
         }
+    }
 
-        if (data["action type"] == "trade") {
-            if (data["trade command"] == "start_trade") {
-                m_game->start_trade(user_character[m_user_name]);
-            } else if (data["trade command"] == "sell_product_in_town") {
-                m_game->sell_product_in_town(
-                    user_character[m_user_name], data["product"]
-                );
-            } else if (data["trade command"] == "buy_product") {
-                m_game->buy_product(
-                    user_character[m_user_name], data["product"]
-                );
-            } else if (data["trade command"] == "sell_product_in_special_cell") {
-                m_game->sell_product_in_special_cell(
-                    user_character[m_user_name], data["product"]
-                );
-            } else if (data["trade command"] == "discard_product") {
-                m_game->discard_product(
-                    user_character[m_user_name], data["product"]
-                );
-            }
-            send_game_for_all();
+    if (data["action type"] == "trade") {
+        if (data["trade command"] == "start_trade") {
+            game.start_trade(character);
+        } else if (data["trade command"] == "sell_product_in_town") {
+            game.sell_product_in_town(character, data["product"]);
+        } else if (data["trade command"] == "buy_product") {
+            game.buy_product(character, data["product"]);
+        } else if (data["trade command"] == "sell_product_in_special_cell") {
+            game.sell_product_in_special_cell(character, data["product"]);
+        } else if (data["trade command"] == "discard_product") {
+            game.discard_product(character, data["product"]);
+        }
+    }
+
+    if (data["action type"] == "adventure") {
+        if (data["adventure command"] == "throw_research_dice") {
+            game.throw_research_dice(character);
+        }
+        if (data["adventure command"] == "complete_card_research") {
+            game.complete_card_research(character, data["outcome"]);
+        }
+        if (data["adventure command"] == "check_characteristic") {
+            game.check_characteristic(character, data["card"], data["option"]);
         }
+    }
+
+    if (data["action type"] == "add_bot") {
+        game.add_bot();
+    }
 
-        if (data["action type"] == "adventure") {
-            if (data["adventure command"] == "throw_research_dice") {
-                m_game->throw_research_dice(user_character[m_user_name]);
+    if (character != nullptr) {
+        auto fight = game.get_current_fight();
+        if (fight != nullptr) {
+            if (fight->check_end_round()) {
+                game.mark_changed(runebound::game::GamePart::FIGHT);
+                fight->start_round(game.get_random());
             }
-            if (data["adventure command"] == "complete_card_research") {
-                m_game->complete_card_research(
-                    user_character[m_user_name], data["outcome"]
-                );
+        }
+    }
+}
+
+// Actions that failed when they were played fail again here, after the
+// same changes, so their exceptions are dropped.
+void replay_journal(runebound::game::Game &game, std::vector<json> &entries) {
+    for (auto &entry : entries) {
+        game.get_random().seed(entry["seed"].get<std::uint64_t>());
+        try {
+            apply_action(
+                game, game.get_character(entry["character"]), entry["action"]
+            );
+        } catch (std::exception &) {
+        }
+    }
+}
+
+void GameRoom::play(
+    const std::shared_ptr<runebound::character::Character> &character,
+    json &action
+) {
+    auto seed = game.get_random()();
+    json entry;
+    entry["character"] = character == nullptr
+                             ? runebound::character::StandardCharacter::NONE
+                             : character->get_standard_character();
+    entry["seed"] = seed;
+    entry["action"] = action;
+    journal.append(std::move(entry));
+    game.get_random().seed(seed);
+    apply_action(game, character, action);
+}
+
+void Connection::handle_action(json &data) {
+    try {
+        if (data["action type"] == "add game") {
+            std::string game_name = data["game name"];
+            auto room =
+                std::make_shared<GameRoom>(m_io_context, game_name, save_folder);
+            Message message;
+            std::vector<std::shared_ptr<Connection>> sessions;
+            {
+                std::lock_guard lock(registry_mutex);
+                if (rooms.count(game_name)) {
+                    throw std::runtime_error("Game is already existing");
+                }
+                game_names.push_back(game_name);
+                rooms[game_name] = room;
+                message = make_game_names_message();
+                for (const auto &session : connections) {
+                    if (auto connection = session.lock()) {
+                        sessions.push_back(std::move(connection));
+                    }
+                }
             }
-            if (data["adventure command"] == "check_characteristic") {
-                m_game->check_characteristic(
-                    user_character[m_user_name], data["card"], data["option"]
-                );
+            for (const auto &session : sessions) {
+                session->write(message);
             }
+            boost::asio::post(room->strand, [room]() { save_game(*room); });
+            return;
+        }
+
+        if (data["action type"] == "join game") {
+            m_user_name = data["user name"];
+            m_user_name += std::to_string(counter++);
+            m_room->users[m_user_name] = {weak_from_this(), true};
+
+            send_game_for_all();
+            return;
+        }
+
+        if (data["action type"] == "resync") {
+            send_game();
+            return;
+        }
+
+        if (GAME_ACTIONS.count(data["action type"]) == 0) {
+            return;
+        }
+        if (m_room == nullptr) {
+            throw std::runtime_error("Join a game first");
+        }
+        m_room->play(m_character, data);
+
+        if (data["action type"] == "exit_game" ||
+            data["action type"] == "exit_game_and_replace_with_bot") {
+            m_room->users.erase(m_user_name);
             send_game_for_all();
+            m_character = nullptr;
+            m_game = nullptr;
+            m_room = nullptr;
+            send_selected_character(
+                runebound::character::StandardCharacter::NONE
+            );
+            return;
         }
 
-        if (data["action type"] == "add_bot") {
-            m_game->add_bot();
+        if (data["action type"] == "select character" ||
+            data["action type"] == "select free character") {
+            runebound::character::StandardCharacter character =
+                data["character"];
+            m_character = m_game->get_character(character);
             send_game_for_all();
+            send_selected_character(character);
+            return;
         }
 
+        send_game_for_all();
+        if (data["action type"] == "pass" &&
+            m_game->get_active_character()->get_state_in_game() ==
+                runebound::character::StateCharacterInGame::BOT) {
+            play_as_bot();
+        }
     } catch (std::exception &e) {
-        std::cout << e.what() << '\n';
-        json answer;
-        answer["change type"] = "exception";
-        answer["exception"] = e.what();
-        write(answer.dump());
+        send_exception(e.what());
     }
 }
 
 void Connection::do_read() {
     auto self(shared_from_this());
-
-    boost::asio::async_read_until(
-        socket_, m_buffer, '\n',
-        [this, self](boost::system::error_code ec, std::size_t length) {
-            if (!ec) {
-                std::istream is(&m_buffer);
-                std::string message;
-                std::getline(is, message);
+    std::string_view bytes(
+        static_cast<const char *>(m_buffer.data().data()), m_buffer.size()
+    );
+    std::size_t frame_size = 0;
+    try {
+        frame_size = runebound::network::get_frame_size(bytes, m_read_format);
+    } catch (std::exception &e) {
+        std::cerr << "Broken message: " << e.what() << std::endl;
+        leave_room();
+        disconnect();
+        return;
+    }
+    if (frame_size != 0) {
+        std::string frame(bytes.substr(0, frame_size));
+        m_buffer.consume(frame_size);
 #ifdef NETWORK_DEBUG_INFO
-                std::cout << "Received: " << message.substr(0, 80) << ' '
-                          << length << '\n';
+        std::cout << "Received: " << frame_size << " bytes\n";
 #endif
-                parse_message(message);
+        parse_message(frame);
+        return;
+    }
+    boost::asio::async_read(
+        socket_, m_buffer, boost::asio::transfer_at_least(1),
+        [this, self](boost::system::error_code ec, std::size_t) {
+            if (!ec) {
                 do_read();
             } else {
-                connections.erase(this);
-                std::cout << "Disconnected" << std::endl;
+                leave_room();
+                disconnect();
             }
         }
     );
 }
 
 void Connection::play_as_bot() {
-    runebound::bot::Bot bot(m_game, this);
-    send_game_for_all();
+    std::make_shared<runebound::bot::Bot>(m_room, bot_think_time)->start();
 }
 
-void Connection::send_game_names() {
+Connection::Message Connection::make_game_names_message() {
     json answer;
     answer["change type"] = "game names";
     answer["game names"] = game_names;
-    write(answer.dump());
+    return make_message(answer);
+}
+
+void Connection::send_game_names() {
+    std::lock_guard lock(registry_mutex);
+    write(make_game_names_message());
 }
 
 void Connection::send_selected_character(
@@ -397,35 +642,70 @@ void Connection::send_selected_character(
     json answer;
     answer["change type"] = "selected character";
     answer["character"] = character;
-    write(answer.dump());
+    write(make_message(answer));
 }
 
 void Connection::send_game_for_all() {
-    if (user_character.contains(m_user_name)) {
-        auto fight = m_game->get_current_fight();
-        if (fight != nullptr) {
-            if (fight->check_end_round()) {
-                fight->start_round();
+    send_game_for_all(*m_room);
+}
+
+void Connection::send_game_for_all(GameRoom &room) {
+    auto &snapshot = room.snapshot;
+    auto patch = snapshot.update(room.game);
+
+    Message message_patch = nullptr;
+    if (!patch.empty()) {
+        json answer;
+        answer["change type"] = "game patch";
+        answer["version"] = snapshot.get_version();
+        answer["patch"] = std::move(patch);
+        message_patch = make_message(answer);
+    }
+    Message message_game = nullptr;
+
+    for (auto it = room.users.begin(); it != room.users.end();) {
+        auto connection = it->second.connection.lock();
+        if (connection == nullptr) {
+            it = room.users.erase(it);
+            continue;
+        }
+        if (it->second.need_full_game) {
+            if (message_game == nullptr) {
+                message_game = make_game_message(snapshot);
             }
+            connection->write(message_game);
+            it->second.need_full_game = false;
+        } else if (message_patch != nullptr) {
+            connection->write(message_patch);
         }
+        ++it;
     }
-    json answer;
 
-    auto game = ::runebound::game::GameClient(*m_game);
+    schedule_save(room);
+}
+
+Connection::Message Connection::make_game_message(
+    const runebound::game::GameClientSnapshot &snapshot
+) {
+    json answer = snapshot.get_state();
     answer["change type"] = "game";
-    runebound::game::to_json(answer, game);
+    answer["version"] = snapshot.get_version();
+    return make_message(answer);
+}
 
-    for (const std::string &user_name : game_users[m_game_name]) {
-        user_connection[user_name]->write(answer.dump());
+void Connection::send_game() {
+    if (m_room == nullptr) {
+        return;
     }
-
-    save_game(m_game_name);
+    write(make_game_message(m_room->snapshot));
+    m_room->users[m_user_name].need_full_game = false;
 }
 
 class Server {
 public:
     Server(boost::asio::io_context &io_context, short port)
-        : m_acceptor(io_context, tcp::endpoint(tcp::v4(), port)) {
+        : m_io_context(io_context),
+          m_acceptor(io_context, tcp::endpoint(tcp::v4(), port)) {
         std::cout << "Server started\n";
         do_accept();
     }
@@ -433,9 +713,13 @@ public:
 private:
     void do_accept() {
         m_acceptor.async_accept(
+            boost::asio::make_strand(m_io_context),
             [this](boost::system::error_code ec, tcp::socket socket) {
                 if (!ec) {
-                    std::make_shared<Connection>(std::move(socket))->start();
+                    std::make_shared<Connection>(
+                        std::move(socket), m_io_context
+                    )
+                        ->start();
                 }
 
                 do_accept();
@@ -443,37 +727,87 @@ private:
         );
     }
 
+    boost::asio::io_context &m_io_context;
     tcp::acceptor m_acceptor;
 };
 
-int main() {
+int main(int argc, char *argv[]) {
     try {
-        std::filesystem::path folder_path = "save";
+        if (argc > 1) {
+            bot_think_time = std::chrono::milliseconds(std::stoi(argv[1]));
+        }
+        int count_threads =
+            std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        if (argc > 2) {
+            count_threads = std::stoi(argv[2]);
+        }
+        if (argc > 3) {
+            save_interval = std::chrono::milliseconds(std::stoi(argv[3]));
+        }
+        boost::asio::io_context io_context(count_threads);
+        save_service =
+            std::make_unique<runebound::network::SaveService>(save_folder);
         for (const auto &entry :
-             std::filesystem::directory_iterator(folder_path)) {
-            if (entry.is_regular_file()) {
+             std::filesystem::directory_iterator(save_folder)) {
+            if (entry.is_regular_file() &&
+                entry.path().extension() == ".json") {
                 std::cout << "Opening file: " << entry.path() << std::endl;
                 std::ifstream file(entry.path());
                 json data;
                 file >> data;
                 std::string game_name = data["game_name"];
                 game_names.push_back(game_name);
-                runebound::game::Game game;
+                auto sequence = data.value("journal_sequence", 0ULL);
+                auto entries = runebound::network::GameJournal::read(
+                    save_folder, game_name, sequence
+                );
+                if (!entries.empty()) {
+                    sequence = entries.back()["sequence"];
+                }
+                auto room = std::make_shared<GameRoom>(
+                    io_context, game_name, save_folder, sequence
+                );
+                auto &game = room->game;
                 from_json(data, game);
+                replay_journal(game, entries);
                 for (const auto &character : game.get_characters()) {
                     if (character->get_state_in_game() ==
                         runebound::character::StateCharacterInGame::PLAYER)
                         game.exit_game(character);
                 }
-                games[game_name] = game;
+                save_game(*room);
+                rooms[game_name] = std::move(room);
             }
         }
-        boost::asio::io_context io_context;
         Server server(io_context, 4444);
-        io_context.run();
+        boost::asio::signal_set signals(io_context, SIGINT, SIGTERM);
+        signals.async_wait([&io_context](boost::system::error_code, int) {
+            io_context.stop();
+        });
+        auto run = [&io_context]() {
+            try {
+                io_context.run();
+            } catch (std::exception &e) {
+                std::cerr << "Exception: " << e.what() << std::endl;
+            }
+        };
+        std::vector<std::thread> workers;
+        for (int i = 1; i < count_threads; ++i) {
+            workers.emplace_back(run);
+        }
+        run();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        for (const auto &[game_name, room] : rooms) {
+            if (room->save_scheduled) {
+                save_game(*room);
+            }
+        }
+        save_service.reset();
     } catch (std::exception &e) {
         std::cerr << "Exception: " << e.what() << std::endl;
     }
 
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
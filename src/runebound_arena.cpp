@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include "fight_arena.hpp"
+
+// Plays duels between two characters loaded from their JSON definitions,
+// for example data/json/characters/lissa.json, on every core, and reports
+// the win rates and the distribution of the lengths of the duels in rounds.
+// A run is repeated with its seed, whatever the number of threads.
+//
+// Usage: runebound_arena <caller.json> <receiver.json> [duels] [threads]
+//        [seed]
+
+namespace {
+runebound::character::Character load_character(const std::string &file) {
+    std::ifstream in(file);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + file);
+    }
+    nlohmann::json json;
+    in >> json;
+    return runebound::character::Character::from_json(json);
+}
+
+double get_percent(std::size_t part, std::size_t total) {
+    return total == 0 ? 0 : 100.0 * static_cast<double>(part) /
+                                static_cast<double>(total);
+}
+
+// The least number of rounds within which the part of the finished duels
+// ends.
+std::size_t get_percentile(
+    const std::vector<std::size_t> &rounds,
+    std::size_t finished,
+    double part
+) {
+    std::size_t count = 0;
+    for (std::size_t length = 0; length < rounds.size(); ++length) {
+        count += rounds[length];
+        if (static_cast<double>(count) >=
+            part * static_cast<double>(finished)) {
+            return length;
+        }
+    }
+    return rounds.size() - 1;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    try {
+        if (argc < 3) {
+            std::cerr << "Usage: runebound_arena <caller.json> <receiver.json> "
+                         "[duels] [threads] [seed]\n";
+            return 1;
+        }
+        auto caller = load_character(argv[1]);
+        auto receiver = load_character(argv[2]);
+        std::size_t count_duels = argc > 3 ? std::stoull(argv[3]) : 1000000;
+        unsigned int count_threads =
+            std::max(1U, std::thread::hardware_concurrency());
+        if (argc > 4) {
+            count_threads = std::max(1, std::stoi(argv[4]));
+        }
+        std::uint64_t seed =
+            argc > 5 ? std::stoull(argv[5])
+                     : std::chrono::steady_clock::now()
+                           .time_since_epoch()
+                           .count();
+
+        auto start = std::chrono::steady_clock::now();
+        auto statistics = runebound::fight::run_arena(
+            caller, receiver, count_duels, seed, count_threads
+        );
+        double elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start
+        )
+                             .count();
+
+        auto finished = statistics.duels - statistics.unfinished;
+        std::size_t total_rounds = 0;
+        for (std::size_t length = 0; length < statistics.rounds.size();
+             ++length) {
+            total_rounds += length * statistics.rounds[length];
+        }
+        std::cout << std::fixed << std::setprecision(2)
+                  << "caller: " << caller.get_name() << '\n'
+                  << "receiver: " << receiver.get_name() << '\n'
+                  << "seed: " << seed << '\n'
+                  << "threads: " << count_threads << '\n'
+                  << "duels: " << statistics.duels << '\n'
+                  << "duels/min: " << statistics.duels / elapsed * 60 << '\n'
+                  << "caller wins: "
+                  << get_percent(statistics.caller_wins, statistics.duels)
+                  << "%\n"
+                  << "receiver wins: "
+                  << get_percent(statistics.receiver_wins, statistics.duels)
+                  << "%\n"
+                  << "unfinished: "
+                  << get_percent(statistics.unfinished, statistics.duels)
+                  << "%\n"
+                  << "average rounds: "
+                  << (finished == 0 ? 0
+                                    : static_cast<double>(total_rounds) /
+                                          static_cast<double>(finished))
+                  << '\n'
+                  << "rounds p50: "
+                  << get_percentile(statistics.rounds, finished, 0.5) << '\n'
+                  << "rounds p90: "
+                  << get_percentile(statistics.rounds, finished, 0.9) << '\n'
+                  << "rounds p99: "
+                  << get_percentile(statistics.rounds, finished, 0.99) << '\n';
+        for (std::size_t length = 0; length < statistics.rounds.size();
+             ++length) {
+            if (statistics.rounds[length] > 0) {
+                std::cout << "rounds " << length << ": "
+                          << get_percent(statistics.rounds[length], finished)
+                          << "%\n";
+            }
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "game.hpp"
+#include "game_simulator.hpp"
+
+// Plays whole games in-process through the Game API, without network and
+// delays, on every core, and reports games/s, the boss fights and the win
+// rate of every character. The policy of the characters is described in
+// game_simulator.hpp. Game i is played with seed + i, whatever thread plays
+// it, so a run can be repeated with its seed.
+//
+// Usage: runebound_sim [games] [players] [threads] [seed]
+
+using runebound::simulator::CHARACTERS;
+
+namespace {
+double get_percent(std::size_t part, std::size_t total) {
+    return total == 0 ? 0 : 100.0 * static_cast<double>(part) /
+                                static_cast<double>(total);
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    try {
+        std::size_t count_games = argc > 1 ? std::stoull(argv[1]) : 10000;
+        std::size_t count_players = std::clamp<std::size_t>(
+            argc > 2 ? std::stoull(argv[2]) : CHARACTERS.size(), 1,
+            CHARACTERS.size()
+        );
+        unsigned int count_threads =
+            std::max(1U, std::thread::hardware_concurrency());
+        if (argc > 3) {
+            count_threads = std::max(1, std::stoi(argv[3]));
+        }
+        unsigned long long seed =
+            argc > 4 ? std::stoull(argv[4])
+                     : std::chrono::steady_clock::now()
+                           .time_since_epoch()
+                           .count();
+
+        // The catalog and the map are parsed once, outside the timing.
+        runebound::game::Game warm_up;
+
+        std::atomic<std::size_t> next_game = 0;
+        std::mutex mutex;
+        runebound::simulator::Statistics total;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < count_threads; ++i) {
+            threads.emplace_back([&]() {
+                runebound::simulator::Statistics statistics;
+                for (auto game = next_game++; game < count_games;
+                     game = next_game++) {
+                    runebound::simulator::play_game(
+                        seed + game, count_players, statistics
+                    );
+                }
+                std::lock_guard lock(mutex);
+                total.add(statistics);
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        double elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start
+        )
+                             .count();
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "seed: " << seed << '\n'
+                  << "threads: " << count_threads << '\n'
+                  << "games: " << total.games << '\n'
+                  << "games/s: " << total.games / elapsed << '\n'
+                  << "average rounds: "
+                  << (total.games == 0 ? 0
+                                       : static_cast<double>(total.rounds) /
+                                             static_cast<double>(total.games))
+                  << '\n'
+                  << "boss fights/game: "
+                  << (total.games == 0
+                          ? 0
+                          : static_cast<double>(total.boss_fights) /
+                                static_cast<double>(total.games))
+                  << '\n'
+                  << "no winner: " << get_percent(total.no_winner, total.games)
+                  << "%\n"
+                  << "stalled: " << get_percent(total.stalled, total.games)
+                  << "%\n"
+                  << "failed: " << total.failed << '\n';
+        for (const auto &[character, name] : CHARACTERS) {
+            auto index = static_cast<std::size_t>(character);
+            if (total.played[index] == 0) {
+                continue;
+            }
+            std::cout << "win rate " << name << ": "
+                      << get_percent(total.wins[index], total.played[index])
+                      << "%, average trophies: "
+                      << static_cast<double>(total.trophies[index]) /
+                             static_cast<double>(total.played[index])
+                      << '\n';
+        }
+        if (!total.first_error.empty()) {
+            std::cout << "first error: " << total.first_error << '\n';
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "save_service.hpp"
+#include <fstream>
+#include <iostream>
+
+namespace runebound::network {
+
+SaveService::SaveService(std::filesystem::path folder)
+    : m_folder(std::move(folder)), m_thread([this]() { run(); }) {
+}
+
+SaveService::~SaveService() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopped = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+void SaveService::save(
+    const std::string &game_name,
+    std::string data,
+    std::function<void()> on_saved
+) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_pending[game_name] = {std::move(data), std::move(on_saved)};
+    }
+    m_condition.notify_all();
+}
+
+void SaveService::flush() {
+    std::unique_lock lock(m_mutex);
+    m_condition.wait(lock, [this]() { return m_pending.empty() && !m_writing; });
+}
+
+void SaveService::run() {
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this]() {
+            return !m_pending.empty() || m_stopped;
+        });
+        if (m_pending.empty()) {
+            return;
+        }
+        auto pending = std::move(m_pending);
+        m_pending.clear();
+        m_writing = true;
+        lock.unlock();
+        for (const auto &[game_name, save] : pending) {
+            if (write_file(game_name, save.data) && save.on_saved) {
+                save.on_saved();
+            }
+        }
+        lock.lock();
+        m_writing = false;
+        m_condition.notify_all();
+    }
+}
+
+bool SaveService::write_file(
+    const std::string &game_name,
+    const std::string &data
+) const {
+    auto path = get_path(game_name);
+    auto temporary_path = path;
+    temporary_path += ".tmp";
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        file << data;
+        file.flush();
+        if (!file) {
+            std::cerr << "Failed to save " << game_name << std::endl;
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error) {
+        std::cerr << "Failed to save " << game_name << ": " << error.message()
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+}  // namespace runebound::network
@@ -0,0 +1,180 @@
+#include "wire_format.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace runebound::network {
+
+namespace {
+const std::size_t LENGTH_BYTES = 4;
+
+const std::array<std::string, COUNT_WIRE_FORMATS> WIRE_FORMAT_NAMES{
+    "json", "cbor", "msgpack", "packed"};
+
+struct Packer {
+    std::map<std::vector<std::string>, std::size_t> shape_ids;
+    nlohmann::json shapes = nlohmann::json::array();
+
+    nlohmann::json pack(const nlohmann::json &value) {
+        if (value.is_object()) {
+            std::vector<std::string> keys;
+            keys.reserve(value.size());
+            for (auto it = value.begin(); it != value.end(); ++it) {
+                keys.push_back(it.key());
+            }
+            auto [it, inserted] =
+                shape_ids.try_emplace(std::move(keys), shape_ids.size());
+            if (inserted) {
+                shapes.push_back(it->first);
+            }
+            auto result = nlohmann::json::array();
+            result.push_back(it->second);
+            for (const auto &element : value) {
+                result.push_back(pack(element));
+            }
+            return result;
+        }
+        if (value.is_array()) {
+            auto result = nlohmann::json::array();
+            result.push_back(nullptr);
+            for (const auto &element : value) {
+                result.push_back(pack(element));
+            }
+            return result;
+        }
+        return value;
+    }
+};
+
+nlohmann::json
+unpack(const nlohmann::json &value, const nlohmann::json &shapes) {
+    if (!value.is_array()) {
+        return value;
+    }
+    if (value.empty()) {
+        throw std::runtime_error("Packed container without a header");
+    }
+    if (value[0].is_null()) {
+        auto result = nlohmann::json::array();
+        for (std::size_t i = 1; i < value.size(); ++i) {
+            result.push_back(unpack(value[i], shapes));
+        }
+        return result;
+    }
+    const auto &keys = shapes.at(value[0].get<std::size_t>());
+    if (keys.size() + 1 != value.size()) {
+        throw std::runtime_error("Packed object does not match its shape");
+    }
+    auto result = nlohmann::json::object();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        result[keys[i].get<std::string>()] = unpack(value[i + 1], shapes);
+    }
+    return result;
+}
+
+std::string make_frame(const std::vector<std::uint8_t> &payload) {
+    if (payload.size() > MAX_MESSAGE_BYTES) {
+        throw std::length_error("Message is too long");
+    }
+    std::string frame(LENGTH_BYTES + payload.size(), '\0');
+    for (std::size_t i = 0; i < LENGTH_BYTES; ++i) {
+        frame[i] = static_cast<char>(
+            (payload.size() >> (8 * (LENGTH_BYTES - 1 - i))) & 0xff
+        );
+    }
+    std::copy(payload.begin(), payload.end(), frame.begin() + LENGTH_BYTES);
+    return frame;
+}
+}  // namespace
+
+std::string to_string(WireFormat format) {
+    return WIRE_FORMAT_NAMES[static_cast<std::size_t>(format)];
+}
+
+WireFormat wire_format_from_string(const std::string &name) {
+    for (std::size_t i = 0; i < COUNT_WIRE_FORMATS; ++i) {
+        if (WIRE_FORMAT_NAMES[i] == name) {
+            return static_cast<WireFormat>(i);
+        }
+    }
+    throw std::runtime_error("Unknown wire format " + name);
+}
+
+std::string encode_message(const nlohmann::json &data, WireFormat format) {
+    switch (format) {
+        case WireFormat::JSON:
+            return data.dump() + '\n';
+        case WireFormat::CBOR:
+            return make_frame(nlohmann::json::to_cbor(data));
+        case WireFormat::MSGPACK:
+            return make_frame(nlohmann::json::to_msgpack(data));
+        case WireFormat::PACKED: {
+            Packer packer;
+            auto packed = packer.pack(data);
+            return make_frame(nlohmann::json::to_cbor(nlohmann::json::array(
+                {std::move(packer.shapes), std::move(packed)}
+            )));
+        }
+    }
+    throw std::runtime_error("Unknown wire format");
+}
+
+std::size_t get_frame_size(std::string_view bytes, WireFormat format) {
+    if (format == WireFormat::JSON) {
+        auto end = bytes.find('\n');
+        if (end != std::string_view::npos) {
+            return end + 1;
+        }
+        if (bytes.size() > MAX_MESSAGE_BYTES) {
+            throw std::length_error("Message is too long");
+        }
+        return 0;
+    }
+    if (bytes.size() < LENGTH_BYTES) {
+        return 0;
+    }
+    std::size_t length = 0;
+    for (std::size_t i = 0; i < LENGTH_BYTES; ++i) {
+        length = (length << 8) | static_cast<std::uint8_t>(bytes[i]);
+    }
+    if (length > MAX_MESSAGE_BYTES) {
+        throw std::length_error("Message is too long");
+    }
+    if (bytes.size() < LENGTH_BYTES + length) {
+        return 0;
+    }
+    return LENGTH_BYTES + length;
+}
+
+nlohmann::json decode_message(std::string_view frame, WireFormat format) {
+    if (format == WireFormat::JSON) {
+        return nlohmann::json::parse(frame.begin(), frame.end());
+    }
+    auto payload = frame.substr(LENGTH_BYTES);
+    switch (format) {
+        case WireFormat::CBOR:
+            return nlohmann::json::from_cbor(payload.begin(), payload.end());
+        case WireFormat::MSGPACK:
+            return nlohmann::json::from_msgpack(payload.begin(), payload.end());
+        default: {
+            auto message =
+                nlohmann::json::from_cbor(payload.begin(), payload.end());
+            if (!message.is_array() || message.size() != 2) {
+                throw std::runtime_error("Packed message without shapes");
+            }
+            return unpack(message[1], message[0]);
+        }
+    }
+}
+
+const std::string &OutgoingMessage::get_frame(WireFormat format) const {
+    auto index = static_cast<std::size_t>(format);
+    std::call_once(m_encoded[index], [&]() {
+        m_frames[index] = encode_message(m_data, format);
+    });
+    return m_frames[index];
+}
+
+}  // namespace runebound::network
@@ -0,0 +1,301 @@
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+#include "fight.hpp"
+#include "fight_evaluator.hpp"
+#include "game.hpp"
+#include "game_client.hpp"
+#include "map.hpp"
+
+// Micro-benchmarks of the hot paths of the engine. Every benchmark is
+// repeated until it has run for MIN_TIME and the results are printed to
+// stdout as JSON:
+// {"context": {...}, "benchmarks": [{"name": ..., "iterations": ...,
+//   "ns_per_iteration": ..., "counters": {...}}]}
+//
+// Usage: runebound_bench [name filter]
+
+using Clock = std::chrono::steady_clock;
+using ::runebound::Point;
+using ::runebound::dice::HandDice;
+using json = nlohmann::json;
+
+namespace {
+const auto MIN_TIME = std::chrono::milliseconds(300);
+const std::size_t COUNT_CASES = 256;
+const unsigned int MAX_COUNT_DICE = 7;
+const unsigned int SEED = 2023;
+
+// Written by every benchmark, so the compiler cannot drop its work.
+volatile std::size_t sink = 0;
+
+class Bench {
+public:
+    explicit Bench(std::string filter) : m_filter(std::move(filter)) {
+    }
+
+    // Runs body(iteration) for a growing number of iterations until the
+    // batch takes MIN_TIME.
+    void run(
+        const std::string &name,
+        const std::function<void(std::size_t)> &body,
+        json counters = json::object()
+    ) {
+        if (name.find(m_filter) == std::string::npos) {
+            return;
+        }
+        std::size_t iterations = 1;
+        Clock::duration elapsed{};
+        while (true) {
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) {
+                body(i);
+            }
+            elapsed = Clock::now() - start;
+            if (elapsed >= MIN_TIME) {
+                break;
+            }
+            iterations *= 2;
+        }
+        double ns_per_iteration =
+            std::chrono::duration<double, std::nano>(elapsed).count() /
+            static_cast<double>(iterations);
+        std::cerr << name << ": " << ns_per_iteration << " ns\n";
+        m_results.push_back(
+            {{"name", name},
+             {"iterations", iterations},
+             {"ns_per_iteration", ns_per_iteration},
+             {"counters", std::move(counters)}}
+        );
+    }
+
+    [[nodiscard]] json get_report() const {
+        json report;
+        report["context"]["min_time_ms"] = MIN_TIME.count();
+        report["context"]["seed"] = SEED;
+#ifdef NDEBUG
+        report["context"]["build"] = "release";
+#else
+        report["context"]["build"] = "debug";
+#endif
+        report["benchmarks"] = m_results;
+        return report;
+    }
+
+private:
+    std::string m_filter;
+    json m_results = json::array();
+};
+
+struct MoveCase {
+    Point start;
+    Point end;
+    std::vector<HandDice> dice;
+};
+
+std::vector<HandDice> make_dice(std::mt19937 &random, std::size_t count) {
+    std::vector<HandDice> dice(count);
+    for (auto &hand_dice : dice) {
+        hand_dice = static_cast<HandDice>(random() % 6);
+    }
+    return dice;
+}
+
+// Random starts and dice; half of the ends are reachable.
+std::vector<MoveCase> make_move_cases(
+    const ::runebound::map::Map &map,
+    std::mt19937 &random,
+    unsigned int count_dice
+) {
+    std::vector<MoveCase> cases;
+    const auto size = map.get_size();
+    while (cases.size() < COUNT_CASES) {
+        MoveCase move_case;
+        move_case.start = Point(random() % size, random() % size);
+        move_case.end = Point(random() % size, random() % size);
+        move_case.dice = make_dice(random, count_dice);
+        if (cases.size() % 2 == 0) {
+            auto moves =
+                map.get_possible_moves(move_case.start, move_case.dice);
+            if (moves.empty()) {
+                continue;
+            }
+            move_case.end = *std::next(moves.begin(), random() % moves.size());
+        }
+        cases.push_back(std::move(move_case));
+    }
+    return cases;
+}
+
+void bench_map(Bench &bench, std::mt19937 &random) {
+    const ::runebound::map::Map map;
+    for (unsigned int count = 1; count <= MAX_COUNT_DICE; ++count) {
+        auto cases = make_move_cases(map, random, count);
+        auto suffix = "/dice:" + std::to_string(count);
+        bench.run("map/check_move" + suffix, [&](std::size_t i) {
+            const auto &move_case = cases[i % cases.size()];
+            sink = sink + map.check_move(
+                              move_case.start, move_case.end, move_case.dice
+                          )
+                              .size();
+        });
+        bench.run("map/get_possible_moves" + suffix, [&](std::size_t i) {
+            const auto &move_case = cases[i % cases.size()];
+            sink = sink +
+                   map.get_possible_moves(move_case.start, move_case.dice)
+                       .size();
+        });
+    }
+}
+
+void bench_research(Bench &bench, std::mt19937 &random) {
+    struct OutcomeCase {
+        const ::runebound::cards::CardResearch *card;
+        int outcome;
+        std::vector<HandDice> dice;
+    };
+
+    auto catalog = ::runebound::game::Catalog::get_standard();
+    std::vector<OutcomeCase> cases;
+    for (std::size_t card = 0; card < catalog->get_count_cards_research();
+         ++card) {
+        const auto &card_research = catalog->get_card_research(card);
+        auto outcomes = card_research.get_outcomes();
+        for (std::size_t outcome = 0; outcome < outcomes.size(); ++outcome) {
+            cases.push_back(
+                {&card_research, static_cast<int>(outcome),
+                 make_dice(random, outcomes[outcome].m_necessary_result.size())}
+            );
+        }
+    }
+    if (cases.empty()) {
+        return;
+    }
+    bench.run("card_research/check_outcome", [&](std::size_t i) {
+        const auto &outcome_case = cases[i % cases.size()];
+        sink = sink + outcome_case.card->check_outcome(
+                          outcome_case.outcome, outcome_case.dice
+                      );
+    });
+}
+
+void bench_fight(Bench &bench) {
+    using ::runebound::fight::Participant;
+    ::runebound::game::Game game(SEED);
+    auto character =
+        game.make_character(::runebound::character::StandardCharacter::LISSA);
+    auto catalog = ::runebound::game::Catalog::get_standard();
+    std::vector<::runebound::fight::Enemy> enemies;
+    for (std::size_t card = 0; card < catalog->get_count_cards_fight();
+         ++card) {
+        enemies.push_back(catalog->get_card_fight(card).get_enemy());
+    }
+    if (enemies.empty()) {
+        return;
+    }
+    std::vector<::runebound::fight::Fight> fights;
+    for (const auto &enemy : enemies) {
+        fights.emplace_back(character, enemy);
+    }
+    // start_round shuffles all tokens of both sides and counts initiative.
+    bench.run("fight/start_round", [&](std::size_t i) {
+        auto &fight = fights[i % fights.size()];
+        fight.start_round(game.get_random());
+        sink = sink + fight.get_remaining_tokens(Participant::CHARACTER).size();
+    });
+    bench.run("fight/construct_and_start_round", [&](std::size_t i) {
+        ::runebound::fight::Fight fight(character, enemies[i % enemies.size()]);
+        fight.start_round(game.get_random());
+        sink = sink + fight.get_remaining_tokens(Participant::ENEMY).size();
+    });
+    bench.run("fight/evaluate", [&](std::size_t i) {
+        auto forecast = ::runebound::fight::evaluate_fight(
+            *character, enemies[i % enemies.size()]
+        );
+        sink = sink + static_cast<std::size_t>(forecast.win_probability * 100);
+    });
+    bench.run("fight/evaluate_uncached", [&](std::size_t i) {
+        const auto &enemy = enemies[i % enemies.size()];
+        ::runebound::fight::FightEvaluator evaluator(
+            character->get_fight_token(), enemy.get_fight_token()
+        );
+        auto forecast =
+            evaluator.evaluate(character->get_health(), enemy.get_health());
+        sink = sink + static_cast<std::size_t>(forecast.win_probability * 100);
+    });
+}
+
+void bench_game(Bench &bench) {
+    ::runebound::game::Game game(SEED);
+    for (auto character :
+         {::runebound::character::StandardCharacter::LISSA,
+          ::runebound::character::StandardCharacter::CORBIN,
+          ::runebound::character::StandardCharacter::ELDER_MOK,
+          ::runebound::character::StandardCharacter::LAUREL_FROM_BLOODWOOD,
+          ::runebound::character::StandardCharacter::LORD_HAWTHORNE,
+          ::runebound::character::StandardCharacter::MASTER_THORN}) {
+        game.make_character(character);
+    }
+    json game_json = game;
+    json game_client_json = ::runebound::game::GameClient(game);
+    auto game_bytes = game_json.dump().size();
+    auto game_client_bytes = game_client_json.dump().size();
+
+    bench.run(
+        "game/to_json",
+        [&](std::size_t) {
+            json result = game;
+            sink = sink + result.size();
+        },
+        {{"bytes", game_bytes}}
+    );
+    bench.run(
+        "game/from_json",
+        [&](std::size_t) {
+            ::runebound::game::Game result;
+            from_json(game_json, result);
+            sink = sink + result.get_turn();
+        },
+        {{"bytes", game_bytes}}
+    );
+    bench.run("game/round_trip", [&](std::size_t) {
+        json state = game;
+        ::runebound::game::Game result;
+        from_json(state, result);
+        sink = sink + result.get_turn();
+    });
+    bench.run("game_client/construct", [&](std::size_t) {
+        ::runebound::game::GameClient game_client(game);
+        sink = sink + game_client.m_characters.size();
+    });
+    bench.run(
+        "game_client/dump",
+        [&](std::size_t) {
+            json state = ::runebound::game::GameClient(game);
+            sink = sink + state.dump().size();
+        },
+        {{"bytes", game_client_bytes}}
+    );
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    try {
+        Bench bench(argc > 1 ? argv[1] : "");
+        std::mt19937 random(SEED);
+        bench_map(bench, random);
+        bench_research(bench, random);
+        bench_fight(bench);
+        bench_game(bench);
+        std::cout << bench.get_report().dump(4) << '\n';
+    } catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -9,7 +9,8 @@ void read_command(
     runebound::fight::Fight &fight,
     const std::vector<runebound::fight::TokenHandCount>
         &character_remaining_tokens,
-    const std::vector<runebound::fight::TokenHandCount> &enemy_remaining_tokens
+    const std::vector<runebound::fight::TokenHandCount> &enemy_remaining_tokens,
+    runebound::Random &random
 ) {
     int k, d;
     using namespace runebound::fight;
@@ -31,12 +32,13 @@ void read_command(
             if (p == 0) {
                 fight.make_dexterity(
                     Participant::CHARACTER, {character_remaining_tokens[k - 1]},
-                    character_remaining_tokens[d - 1], Participant::CHARACTER
+                    character_remaining_tokens[d - 1], Participant::CHARACTER,
+                    random
                 );
             } else {
                 fight.make_dexterity(
                     Participant::CHARACTER, character_remaining_tokens[k - 1],
-                    enemy_remaining_tokens[d - 1], Participant::ENEMY
+                    enemy_remaining_tokens[d - 1], Participant::ENEMY, random
                 );
             }
 
@@ -61,12 +63,13 @@ void read_command(
             if (p == 0) {
                 fight.make_dexterity(
                     Participant::ENEMY, enemy_remaining_tokens[k - 1],
-                    character_remaining_tokens[d - 1], Participant::CHARACTER
+                    character_remaining_tokens[d - 1], Participant::CHARACTER,
+                    random
                 );
             } else {
                 fight.make_dexterity(
                     Participant::ENEMY, enemy_remaining_tokens[k - 1],
-                    enemy_remaining_tokens[d - 1], Participant::ENEMY
+                    enemy_remaining_tokens[d - 1], Participant::ENEMY, random
                 );
             }
 
@@ -112,7 +115,7 @@ TEST_CASE("Fight") {
         );
     auto enemy = Enemy(5, "ABC");
     Fight fight = Fight(character, enemy);
-    fight.start_round();
+    fight.start_round(game.get_random());
     Participant turn = fight.get_turn();
     auto character_remaining_tokens = fight.get_character_remaining_tokens();
     auto enemy_remaining_tokens = fight.get_enemy_remaining_tokens();
@@ -128,13 +131,14 @@ TEST_CASE("Fight") {
         std::cout << "CHARACTER HEALTH: " << character->get_health() << "; "
                   << "ENEMY HEALTH: " << fight.get_health_enemy() << '\n';
         if (fight.check_end_round()) {
-            fight.start_round();
+            fight.start_round(game.get_random());
             character_remaining_tokens = fight.get_character_remaining_tokens();
             enemy_remaining_tokens = fight.get_enemy_remaining_tokens();
             continue;
         }
         runebound::tests::read_command(
-            fight, character_remaining_tokens, enemy_remaining_tokens
+            fight, character_remaining_tokens, enemy_remaining_tokens,
+            game.get_random()
         );
         if (fight.check_end_fight()) {
             if (turn == runebound::fight::Participant::ENEMY) {
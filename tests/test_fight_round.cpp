@@ -0,0 +1,100 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "doctest/doctest.h"
+#include "fight.hpp"
+#include "game.hpp"
+
+// Replaces the global allocation functions of the test binary to count the
+// allocations of a thread while it asks for it.
+namespace {
+thread_local bool counting = false;
+std::atomic<std::size_t> count_allocations = 0;
+}  // namespace
+
+void *operator new(std::size_t size) {
+    if (counting) {
+        ++count_allocations;
+    }
+    if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+int count_shields(
+    const runebound::fight::Fight &fight,
+    runebound::fight::Participant participant
+) {
+    int shields = 0;
+    for (const auto &token : fight.get_remaining_tokens(participant)) {
+        if (token.hand == runebound::fight::HandFightTokens::SHIELD) {
+            shields += token.count;
+        }
+    }
+    return shields;
+}
+}  // namespace
+
+TEST_CASE("fight rounds do not allocate") {
+    using namespace runebound::fight;
+    runebound::game::Game game(11);
+    auto character =
+        game.make_character(runebound::character::StandardCharacter::LISSA);
+    character->update_max_health(10000);
+    character->relax();
+    // The tokens of the boss deal damage and hold shields. The boss itself
+    // heals up to its 15 health on a hit, so its copy gets the health.
+    Fight fight(
+        character,
+        Enemy(100000, Enemy(runebound::AdventureType::BOSS).get_fight_token())
+    );
+    std::vector<TokenHandCount> used;
+    used.reserve(character->get_fight_token().size() + 8);
+    int consumed_shields = 0;
+
+    counting = true;
+    for (int round = 0; round < 100; ++round) {
+        fight.start_round(game.get_random());
+        while (!fight.check_end_round() && !fight.check_end_fight()) {
+            auto participant = fight.get_turn();
+            used.clear();
+            for (const auto &token : fight.get_remaining_tokens(participant)) {
+                if (token.hand == HandFightTokens::PHYSICAL_DAMAGE ||
+                    token.hand == HandFightTokens::MAGICAL_DAMAGE ||
+                    token.hand == HandFightTokens::ENEMY_DAMAGE) {
+                    if (used.empty() || used[0].hand == token.hand) {
+                        used.push_back(token);
+                    }
+                }
+            }
+            if (!used.empty()) {
+                auto defender = participant == Participant::CHARACTER
+                                    ? Participant::ENEMY
+                                    : Participant::CHARACTER;
+                auto shields = count_shields(fight, defender);
+                fight.make_damage(participant, used);
+                consumed_shields += shields - count_shields(fight, defender);
+            } else if (participant == Participant::CHARACTER) {
+                fight.pass_character();
+            } else {
+                fight.pass_enemy();
+            }
+        }
+    }
+    counting = false;
+    CHECK(fight.get_number_of_rounds() == 100);
+    CHECK(!fight.check_end_fight());
+    CHECK(consumed_shields > 0);
+    CHECK(count_allocations == 0);
+}
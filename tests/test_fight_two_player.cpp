@@ -10,7 +10,8 @@ void read_command(
     runebound::fight::FightTwoPlayer &fight,
     const std::vector<runebound::fight::TokenHandCount>
         &character_remaining_tokens,
-    const std::vector<runebound::fight::TokenHandCount> &enemy_remaining_tokens
+    const std::vector<runebound::fight::TokenHandCount> &enemy_remaining_tokens,
+    runebound::Random &random
 ) {
     int k, d;
     using namespace runebound::fight;
@@ -35,14 +36,14 @@ void read_command(
                     ParticipantTwoPlayers::CALLER,
                     {character_remaining_tokens[k - 1]},
                     character_remaining_tokens[d - 1],
-                    ParticipantTwoPlayers::CALLER
+                    ParticipantTwoPlayers::CALLER, random
                 );
             } else {
                 fight.make_dexterity(
                     ParticipantTwoPlayers::CALLER,
                     character_remaining_tokens[k - 1],
                     enemy_remaining_tokens[d - 1],
-                    ParticipantTwoPlayers::RECEIVER
+                    ParticipantTwoPlayers::RECEIVER, random
                 );
             }
 
@@ -70,14 +71,14 @@ void read_command(
                     ParticipantTwoPlayers::RECEIVER,
                     enemy_remaining_tokens[k - 1],
                     character_remaining_tokens[d - 1],
-                    ParticipantTwoPlayers::CALLER
+                    ParticipantTwoPlayers::CALLER, random
                 );
             } else {
                 fight.make_dexterity(
                     ParticipantTwoPlayers::RECEIVER,
                     enemy_remaining_tokens[k - 1],
                     enemy_remaining_tokens[d - 1],
-                    ParticipantTwoPlayers::RECEIVER
+                    ParticipantTwoPlayers::RECEIVER, random
                 );
             }
 
@@ -100,7 +101,7 @@ TEST_CASE("fight two players") {
     runebound::fight::FightTwoPlayer fight(lissa, mok);
     CHECK(lissa->get_health() == 9);
     CHECK(mok->get_health() == 9);
-    fight.start_round();
+    fight.start_round(game.get_random());
     runebound::fight::ParticipantTwoPlayers turn = fight.get_turn();
     auto caller_remaining_tokens = fight.get_caller_remaining_tokens();
     auto receiver_remaining_tokens = fight.get_receiver_remaining_tokens();
@@ -117,13 +118,14 @@ TEST_CASE("fight two players") {
         std::cout << "LISSA HEALTH: " << lissa->get_health() << "; "
                   << "MOK HEALTH: " << mok->get_health() << '\n';
         if (fight.check_end_round()) {
-            fight.start_round();
+            fight.start_round(game.get_random());
             caller_remaining_tokens = fight.get_caller_remaining_tokens();
             receiver_remaining_tokens = fight.get_receiver_remaining_tokens();
             continue;
         }
         runebound::tests::read_command(
-            fight, caller_remaining_tokens, receiver_remaining_tokens
+            fight, caller_remaining_tokens, receiver_remaining_tokens,
+            game.get_random()
         );
         if (fight.check_end_fight()) {
             if (turn == runebound::fight::ParticipantTwoPlayers::CALLER) {
@@ -1,6 +1,15 @@
+#include <algorithm>
+#include <cmath>
+#include <set>
 #include "doctest/doctest.h"
+#include "catalog.hpp"
+#include "fight_arena.hpp"
+#include "fight_evaluator.hpp"
+#include "fight_policy.hpp"
 #include "fight_two_player.hpp"
 #include "game.hpp"
+#include "game_client.hpp"
+#include "game_simulator.hpp"
 
 TEST_CASE("game") {
     ::runebound::generator::generate_characters();
@@ -325,7 +334,7 @@ TEST_CASE("fight boss") {
         lissa, runebound::fight::Enemy(runebound::AdventureType::BOSS)
     );
     CHECK(fight.get_health_enemy() == 15);
-    fight.start_round();
+    fight.start_round(game.get_random());
     CHECK(fight.get_health_enemy() == 9);
 }
 
@@ -451,6 +460,39 @@ TEST_CASE("neighbours cells") {
     CHECK(game.get_possible_moves().size() > 6);
 }
 
+TEST_CASE("possible moves cache") {
+    runebound::game::Game game;
+    auto lissa =
+        game.make_character(runebound::character::StandardCharacter::LISSA);
+    auto mok =
+        game.make_character(runebound::character::StandardCharacter::ELDER_MOK);
+    game.throw_movement_dice(lissa);
+    const auto &moves = game.get_possible_moves();
+    auto expected = game.get_map().get_possible_moves(
+        lissa->get_position(), game.get_last_dice_movement_result()
+    );
+    expected.erase(lissa->get_position());
+    expected.erase(mok->get_position());
+    CHECK(std::set<runebound::Point>(moves.begin(), moves.end()) == expected);
+
+    const auto &cells = game.get_possible_moves_cells();
+    std::size_t count_cells = 0;
+    for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+        count_cells += cells[cell];
+    }
+    CHECK(count_cells == moves.size());
+    CHECK(&game.get_possible_moves() == &moves);
+
+    auto move = moves.front();
+    game.make_move(lissa, move);
+    CHECK(
+        std::find(
+            game.get_possible_moves().begin(), game.get_possible_moves().end(),
+            move
+        ) == game.get_possible_moves().end()
+    );
+}
+
 TEST_CASE("to_json from_json game") {
     runebound::game::Game game;
     auto lissa =
@@ -502,4 +544,298 @@ TEST_CASE("exit and join game") {
         runebound::character::StateCharacterInGame::BOT
     );
     CHECK(game.get_free_characters().size() == 1);
-}
\ No newline at end of file
+}
+
+TEST_CASE("game client patch") {
+    runebound::game::Game game;
+    auto lissa =
+        game.make_character(runebound::character::StandardCharacter::LISSA);
+    runebound::game::GameClientSnapshot snapshot;
+    snapshot.update(game);
+    CHECK(snapshot.get_version() == 1);
+    auto client_state = snapshot.get_state();
+    game.throw_movement_dice(lissa);
+    auto patch = snapshot.update(game);
+    CHECK(snapshot.get_version() == 2);
+    client_state = client_state.patch(patch);
+    CHECK(client_state == snapshot.get_state());
+    CHECK(patch.dump().size() * 10 < client_state.dump().size());
+    runebound::game::GameClient game_client;
+    runebound::game::from_json(client_state, game_client);
+    CHECK(game_client.m_possible_moves == game.get_possible_moves());
+    CHECK(snapshot.update(game).empty());
+    CHECK(snapshot.get_version() == 2);
+}
+
+TEST_CASE("game client patches follow the whole state") {
+    runebound::game::Game game(2023);
+    game.make_character(runebound::character::StandardCharacter::LISSA);
+    game.make_character(runebound::character::StandardCharacter::CORBIN);
+    runebound::game::GameClientSnapshot snapshot;
+    auto client_state = nlohmann::json().patch(snapshot.update(game));
+    for (int turn = 0; !game.check_end_game(); ++turn) {
+        auto character = game.get_active_character();
+        game.throw_movement_dice(character);
+        const auto &moves = game.get_possible_moves();
+        if (!moves.empty()) {
+            auto dice = game.get_last_dice_movement_result();
+            game.make_move(character, moves[turn % moves.size()], dice);
+        }
+        if (turn % 7 == 0) {
+            try {
+                game.take_token(character);
+            } catch (std::exception &) {
+            }
+        }
+        client_state = client_state.patch(snapshot.update(game));
+        game.start_next_character_turn(character);
+        client_state = client_state.patch(snapshot.update(game));
+        CHECK(client_state == nlohmann::json(runebound::game::GameClient(game)));
+    }
+    CHECK(client_state == snapshot.get_state());
+}
+
+TEST_CASE("games share catalog") {
+    runebound::game::Game first;
+    runebound::game::Game second;
+    nlohmann::json json;
+    runebound::game::to_json(json, first);
+    CHECK(!json.contains("m_all_cards_fight"));
+    CHECK(!json.contains("m_all_products"));
+
+    auto catalog = runebound::game::Catalog::get_standard();
+    CHECK(catalog == runebound::game::Catalog::get_standard());
+    runebound::game::to_json(json, *catalog);
+    json["m_all_products"][0]["m_price"] = 1000;
+    runebound::game::from_json(json, second);
+    CHECK(second.get_product(0).get_price() == 1000);
+    CHECK(first.get_product(0).get_price() == catalog->get_product(0).get_price());
+    nlohmann::json json_second;
+    runebound::game::to_json(json_second, second);
+    CHECK(json_second["m_all_products"][0]["m_price"] == 1000);
+}
+
+TEST_CASE("games replay from their seed") {
+    runebound::game::Game first(7);
+    runebound::game::Game second(7);
+    for (auto *game : {&first, &second}) {
+        auto lissa = game->make_character(
+            runebound::character::StandardCharacter::LISSA
+        );
+        game->throw_movement_dice(lissa);
+    }
+    nlohmann::json json_first;
+    nlohmann::json json_second;
+    runebound::game::to_json(json_first, first);
+    runebound::game::to_json(json_second, second);
+    CHECK(json_first == json_second);
+
+    runebound::game::Game loaded;
+    runebound::game::from_json(json_first, loaded);
+    CHECK(loaded.get_random() == first.get_random());
+    CHECK(loaded.get_random()() == first.get_random()());
+    CHECK(runebound::game::Game(8).get_random() != first.get_random());
+}
+
+TEST_CASE("simulated games fight the boss and end with winners") {
+    runebound::simulator::Statistics statistics;
+    for (std::uint64_t seed = 1; seed <= 120; ++seed) {
+        runebound::simulator::play_game(seed, 1, statistics);
+    }
+    CHECK(statistics.first_error == "");
+    CHECK(statistics.failed == 0);
+    CHECK(statistics.stalled == 0);
+    CHECK(statistics.boss_fights > 0);
+    CHECK(statistics.no_winner < statistics.games);
+}
+
+TEST_CASE("research outcomes match permutation search") {
+    using runebound::dice::HandDice;
+    using runebound::map::TypeCell;
+    runebound::Random random(2023);
+    for (int test = 0; test < 500; ++test) {
+        std::vector<TypeCell> necessary_result(1 + random() % 4);
+        for (auto &type : necessary_result) {
+            type = static_cast<TypeCell>(random() % 6);
+        }
+        std::vector<HandDice> dice(1 + random() % 5);
+        runebound::dice::throw_dice(dice, random);
+        runebound::cards::CardResearch::Outcome outcome(
+            0, 0, 0, necessary_result
+        );
+        runebound::cards::CardResearch card("card", "territory", {outcome});
+        auto permutation = dice;
+        std::sort(permutation.begin(), permutation.end());
+        bool expected = false;
+        do {
+            bool completed = true;
+            for (std::size_t i = 0;
+                 i < std::min(permutation.size(), necessary_result.size());
+                 ++i) {
+                completed &= runebound::dice::check_hand_dice(
+                    necessary_result[i], permutation[i]
+                );
+            }
+            expected |= completed;
+        } while (
+            std::next_permutation(permutation.begin(), permutation.end())
+        );
+        auto copy = dice;
+        CHECK(card.check_outcome(0, dice) == expected);
+        CHECK(dice == copy);
+    }
+}
+
+TEST_CASE("fight evaluator") {
+    using namespace runebound::fight;
+    FightEvaluator duel(
+        {FightToken(
+            HandFightTokens::PHYSICAL_DAMAGE, 0, 1, HandFightTokens::NOTHING, 0,
+            0
+        )},
+        {FightToken(
+            HandFightTokens::ENEMY_DAMAGE, 0, 1, HandFightTokens::NOTHING, 0, 0
+        )}
+    );
+    // The character strikes first: it wins a round with probability 1/2 and
+    // loses it with probability 1/4.
+    auto forecast = duel.evaluate(1, 1);
+    CHECK(forecast.win_probability == doctest::Approx(2.0 / 3));
+    CHECK(forecast.expected_rounds == doctest::Approx(4.0 / 3));
+    CHECK(duel.evaluate(1, 0).win_probability == 1);
+    CHECK(duel.evaluate(0, 1).win_probability == 0);
+    CHECK(
+        duel.evaluate(3, 2).win_probability >
+        duel.evaluate(2, 3).win_probability
+    );
+
+    FightToken shield(
+        HandFightTokens::SHIELD, 0, 1, HandFightTokens::NOTHING, 0, 0
+    );
+    FightEvaluator shields({shield}, {shield});
+    CHECK(shields.evaluate(5, 5).win_probability == 0);
+    CHECK(std::isinf(shields.evaluate(5, 5).expected_rounds));
+
+    runebound::game::Game game(7);
+    auto lissa =
+        game.make_character(runebound::character::StandardCharacter::LISSA);
+    Enemy boss(runebound::AdventureType::BOSS);
+    auto against_boss = evaluate_fight(*lissa, boss);
+    CHECK(against_boss.win_probability >= 0);
+    CHECK(against_boss.win_probability <= 1);
+    FightEvaluator evaluator(lissa->get_fight_token(), boss.get_fight_token());
+    double previous = 1;
+    for (int health = 1; health <= boss.get_health(); ++health) {
+        auto win_probability =
+            evaluator.evaluate(lissa->get_health(), health).win_probability;
+        CHECK(win_probability <= previous);
+        previous = win_probability;
+    }
+}
+
+TEST_CASE("fight evaluator matches played fights") {
+    using namespace runebound::fight;
+    runebound::game::Game game(5);
+    auto lissa =
+        game.make_character(runebound::character::StandardCharacter::LISSA);
+    const int count_fights = 4000;
+    std::vector<TokenHandCount> used;
+    for (int enemy_health : {2, 4, 6}) {
+        // The enemies of fight cards have the default tokens of an enemy.
+        Enemy enemy(enemy_health, "Bandit");
+        lissa->set_health(lissa->get_max_health());
+        auto forecast = evaluate_fight(*lissa, enemy);
+        runebound::Random random(enemy_health);
+        int wins = 0;
+        for (int i = 0; i < count_fights; ++i) {
+            lissa->set_health(lissa->get_max_health());
+            Fight fight(lissa, enemy);
+            while (!fight.check_end_fight()) {
+                fight.start_round(random);
+                while (!fight.check_end_fight() && !fight.check_end_round()) {
+                    make_policy_move(fight, used);
+                }
+            }
+            if (fight.get_winner() == Participant::CHARACTER) {
+                ++wins;
+            }
+        }
+        auto win_rate = static_cast<double>(wins) / count_fights;
+        CHECK(std::abs(win_rate - forecast.win_probability) < 0.03);
+    }
+
+    std::vector<FightToken> tokens(
+        MAX_EVALUATED_TOKENS + 1,
+        FightToken(
+            HandFightTokens::PHYSICAL_DAMAGE, 0, 1, HandFightTokens::NOTHING, 0,
+            0
+        )
+    );
+    CHECK_THROWS_AS(
+        FightEvaluator(tokens, lissa->get_fight_token()),
+        TooManyFightTokensException
+    );
+}
+
+TEST_CASE("packed fight tokens keep json format") {
+    using namespace runebound::fight;
+    FightToken token(
+        HandFightTokens::NOTHING, true, 3, HandFightTokens::SHIELD, false, 2
+    );
+    nlohmann::json json = token;
+    CHECK(
+        json == nlohmann::json{
+                    {"first", 7},
+                    {"first_lead", true},
+                    {"first_count", 3},
+                    {"second", 6},
+                    {"second_lead", false},
+                    {"second_count", 2}}
+    );
+    CHECK(json.get<FightToken>() == token);
+    FightToken other(
+        HandFightTokens::NOTHING, true, 3, HandFightTokens::SHIELD, true, 2
+    );
+    CHECK(other.get_code() != token.get_code());
+    CHECK_FALSE(other == token);
+    json["first_count"] = FightToken::MAX_COUNT + 1;
+    CHECK_THROWS_AS(json.get<FightToken>(), std::out_of_range);
+
+    TokenHandCount hand_count(token, HandFightTokens::SHIELD, 4);
+    nlohmann::json hand_count_json = hand_count;
+    CHECK(hand_count_json["hand"] == 6);
+    CHECK(hand_count_json.get<TokenHandCount>() == hand_count);
+}
+
+TEST_CASE("arena duels do not depend on threads") {
+    using namespace runebound::fight;
+    runebound::character::Character lissa(
+        runebound::character::StandardCharacter::LISSA
+    );
+    runebound::character::Character mok(
+        runebound::character::StandardCharacter::ELDER_MOK
+    );
+    auto caller = std::make_shared<runebound::character::Character>(lissa);
+    auto receiver = std::make_shared<runebound::character::Character>(mok);
+    runebound::Random random(5);
+    auto duel = play_duel(caller, receiver, random);
+    REQUIRE(duel.finished);
+    CHECK(duel.rounds >= 1);
+    if (duel.winner == ParticipantTwoPlayers::CALLER) {
+        CHECK(receiver->get_health() == 0);
+    } else {
+        CHECK(caller->get_health() == 0);
+    }
+
+    auto one_thread = run_arena(lissa, mok, 1000, 17, 1);
+    auto three_threads = run_arena(lissa, mok, 1000, 17, 3);
+    CHECK(one_thread.duels == 1000);
+    CHECK(
+        one_thread.caller_wins + one_thread.receiver_wins +
+            one_thread.unfinished ==
+        1000
+    );
+    CHECK(three_threads.caller_wins == one_thread.caller_wins);
+    CHECK(three_threads.receiver_wins == one_thread.receiver_wins);
+    CHECK(three_threads.rounds == one_thread.rounds);
+}
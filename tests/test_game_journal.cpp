@@ -0,0 +1,44 @@
+#include <filesystem>
+#include <fstream>
+#include "doctest/doctest.h"
+#include "game_journal.hpp"
+
+TEST_CASE("game journal replays entries after snapshot") {
+    using ::runebound::network::GameJournal;
+    auto folder = std::filesystem::temp_directory_path() / "runebound_journal";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    {
+        GameJournal journal(folder, "game");
+        for (int i = 0; i < 5; ++i) {
+            journal.append({{"action", i}});
+        }
+        journal.start_segment();
+        for (int i = 5; i < 8; ++i) {
+            journal.append({{"action", i}});
+        }
+        CHECK(journal.get_sequence() == 8);
+        GameJournal other(folder, "game.other");
+        other.append({{"action", 100}});
+
+        auto entries = GameJournal::read(folder, "game", 3);
+        REQUIRE(entries.size() == 5);
+        for (int i = 0; i < 5; ++i) {
+            CHECK(entries[i]["action"] == i + 3);
+            CHECK(entries[i]["sequence"] == i + 4);
+        }
+
+        journal.remove_segments_up_to(4);
+        CHECK(GameJournal::read(folder, "game", 0).size() == 8);
+        journal.remove_segments_up_to(5);
+        entries = GameJournal::read(folder, "game", 0);
+        REQUIRE(entries.size() == 3);
+        CHECK(entries.front()["sequence"] == 6);
+    }
+    {
+        std::ofstream torn(folder / "game.6.journal", std::ios::app);
+        torn << "{\"action\": 8, \"seq";
+    }
+    CHECK(GameJournal::read(folder, "game", 0).size() == 3);
+    std::filesystem::remove_all(folder);
+}
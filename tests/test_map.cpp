@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <vector>
+#include "doctest/doctest.h"
+#include "map.hpp"
+#include "map_grid.hpp"
+#include "map_neighbours.hpp"
+#include "random.hpp"
+
+namespace runebound::tests {
+namespace {
+using ::runebound::dice::HandDice;
+
+bool check_step_permutation(
+    const ::runebound::map::Map &map,
+    const Point &current,
+    const Point &new_point,
+    HandDice dice
+) {
+    return (map.get_cell_map(new_point).check_road() ||
+            (!map.check_river(current, new_point) &&
+             ::runebound::dice::check_hand_dice(
+                 map.get_cell_map(new_point).get_type_cell(), dice
+             ))) ||
+           (map.check_river(current, new_point) &&
+            (dice == HandDice::JOKER || dice == HandDice::MOUNTAINS_WATER));
+}
+
+// Reference implementation: a breadth-first search for every permutation of
+// the dice, as the map used to do it.
+std::vector<Point> make_move_permutation(
+    const ::runebound::map::Map &map,
+    const Point &start,
+    const Point &end,
+    const std::vector<HandDice> &dice_roll_results
+) {
+    const auto count_dice = static_cast<int>(dice_roll_results.size());
+    std::map<Point, int> dist;
+    std::map<Point, Point> parent;
+    dist[start] = 0;
+    parent[start] = Point(-1, -1);
+    std::queue<Point> bfs_queue;
+    bfs_queue.push(start);
+    while (!bfs_queue.empty()) {
+        auto current = bfs_queue.front();
+        bfs_queue.pop();
+        if (current == end) {
+            std::vector<Point> result;
+            while (current != Point(-1, -1)) {
+                result.push_back(current);
+                current = parent[current];
+            }
+            std::reverse(result.begin(), result.end());
+            return result;
+        }
+        if (dist[current] >= count_dice) {
+            continue;
+        }
+        for (const auto &direction : map.get_directions(current)) {
+            if (!map.check_neighbour_in_direction(current, direction)) {
+                continue;
+            }
+            auto new_point = map.get_neighbour_in_direction(current, direction);
+            if (!dist.count(new_point) &&
+                check_step_permutation(
+                    map, current, new_point, dice_roll_results[dist[current]]
+                )) {
+                dist[new_point] = dist[current] + 1;
+                parent[new_point] = current;
+                bfs_queue.push(new_point);
+            }
+        }
+    }
+    return {};
+}
+
+std::vector<Point> check_move_permutation(
+    const ::runebound::map::Map &map,
+    const Point &start,
+    const Point &end,
+    std::vector<HandDice> dice_roll_results
+) {
+    if (map.check_neighbour(start, end)) {
+        return {start, end};
+    }
+    std::sort(dice_roll_results.begin(), dice_roll_results.end());
+    do {
+        auto result = make_move_permutation(map, start, end, dice_roll_results);
+        if (!result.empty()) {
+            return result;
+        }
+    } while (std::next_permutation(
+        dice_roll_results.begin(), dice_roll_results.end()
+    ));
+    return {};
+}
+
+std::set<Point> get_possible_moves_permutation(
+    const ::runebound::map::Map &map,
+    const Point &start,
+    std::vector<HandDice> dice_roll_results
+) {
+    auto neighbours = map.get_neighbours(start);
+    std::set<Point> result(neighbours.begin(), neighbours.end());
+    if (dice_roll_results.empty()) {
+        return result;
+    }
+    std::sort(dice_roll_results.begin(), dice_roll_results.end());
+    do {
+        std::map<Point, int> dist;
+        dist[start] = 0;
+        std::queue<Point> bfs_queue;
+        bfs_queue.push(start);
+        while (!bfs_queue.empty()) {
+            auto current = bfs_queue.front();
+            bfs_queue.pop();
+            if (dist[current] >= static_cast<int>(dice_roll_results.size())) {
+                continue;
+            }
+            for (const auto &direction : map.get_directions(current)) {
+                if (!map.check_neighbour_in_direction(current, direction)) {
+                    continue;
+                }
+                auto new_point =
+                    map.get_neighbour_in_direction(current, direction);
+                if (!dist.count(new_point) &&
+                    check_step_permutation(
+                        map, current, new_point,
+                        dice_roll_results[dist[current]]
+                    )) {
+                    dist[new_point] = dist[current] + 1;
+                    bfs_queue.push(new_point);
+                }
+            }
+        }
+        for (const auto &move : dist) {
+            result.insert(move.first);
+        }
+    } while (std::next_permutation(
+        dice_roll_results.begin(), dice_roll_results.end()
+    ));
+    return result;
+}
+
+bool check_path(
+    const ::runebound::map::Map &map,
+    const std::vector<Point> &path,
+    std::vector<HandDice> dice_roll_results
+) {
+    if (path.size() == 2 && map.check_neighbour(path[0], path[1])) {
+        return true;
+    }
+    if (path.size() > dice_roll_results.size() + 1) {
+        return false;
+    }
+    std::sort(dice_roll_results.begin(), dice_roll_results.end());
+    do {
+        bool correct = true;
+        for (std::size_t i = 1; i < path.size() && correct; ++i) {
+            correct = map.check_neighbour(path[i - 1], path[i]) &&
+                      check_step_permutation(
+                          map, path[i - 1], path[i], dice_roll_results[i - 1]
+                      );
+        }
+        if (correct) {
+            return true;
+        }
+    } while (std::next_permutation(
+        dice_roll_results.begin(), dice_roll_results.end()
+    ));
+    return false;
+}
+}  // namespace
+}  // namespace runebound::tests
+
+TEST_CASE("possible moves match permutation search") {
+    ::runebound::map::Map map;
+    std::mt19937 random(2023);
+    for (int test = 0; test < 150; ++test) {
+        runebound::Point start(
+            static_cast<int>(random() % map.get_size()),
+            static_cast<int>(random() % map.get_size())
+        );
+        std::vector<runebound::dice::HandDice> dice(1 + test % 5);
+        for (auto &hand_dice : dice) {
+            hand_dice = static_cast<runebound::dice::HandDice>(random() % 6);
+        }
+        CHECK(
+            map.get_possible_moves(start, dice) ==
+            runebound::tests::get_possible_moves_permutation(map, start, dice)
+        );
+    }
+}
+
+TEST_CASE("check move matches permutation search") {
+    ::runebound::map::Map map;
+    std::mt19937 random(2024);
+    for (int test = 0; test < 60; ++test) {
+        runebound::Point start(
+            static_cast<int>(random() % map.get_size()),
+            static_cast<int>(random() % map.get_size())
+        );
+        std::vector<runebound::dice::HandDice> dice(1 + test % 5);
+        for (auto &hand_dice : dice) {
+            hand_dice = static_cast<runebound::dice::HandDice>(random() % 6);
+        }
+        for (int row = 0; row < map.get_size(); row += 2) {
+            for (int column = 0; column < map.get_size(); column += 2) {
+                runebound::Point end(row, column);
+                auto path = map.check_move(start, end, dice);
+                auto expected = runebound::tests::check_move_permutation(
+                    map, start, end, dice
+                );
+                REQUIRE(path.empty() == expected.empty());
+                if (!path.empty()) {
+                    CHECK(path.front() == start);
+                    CHECK(path.back() == end);
+                    CHECK(path.size() <= expected.size());
+                    CHECK(runebound::tests::check_path(map, path, dice));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("possible moves with seven dice") {
+    ::runebound::map::Map map;
+    std::mt19937 random(2025);
+    for (int test = 0; test < 3; ++test) {
+        runebound::Point start(
+            static_cast<int>(random() % map.get_size()),
+            static_cast<int>(random() % map.get_size())
+        );
+        std::vector<runebound::dice::HandDice> dice(7);
+        for (auto &hand_dice : dice) {
+            hand_dice = static_cast<runebound::dice::HandDice>(random() % 6);
+        }
+        CHECK(
+            map.get_possible_moves(start, dice) ==
+            runebound::tests::get_possible_moves_permutation(map, start, dice)
+        );
+    }
+}
+
+TEST_CASE("map grid keeps json format") {
+    nlohmann::json json;
+    std::ifstream in("data/json/map/map.json");
+    in >> json;
+    ::runebound::map::Map map;
+    nlohmann::json json_after;
+    ::runebound::map::to_json(json_after, map);
+    CHECK(json_after["m_map"] == json["m_map"]);
+    auto cells = map.get_full_map();
+    for (int row = 0; row < map.get_size(); ++row) {
+        for (int column = 0; column < map.get_size(); ++column) {
+            auto cell = map.get_cell_map(runebound::Point(row, column));
+            CHECK(cells[row][column].get_type_cell() == cell.get_type_cell());
+            CHECK(
+                cells[row][column].get_territory_name() ==
+                cell.get_territory_name()
+            );
+        }
+    }
+}
+
+TEST_CASE("map grid limits territory names") {
+    nlohmann::json json;
+    std::ifstream in("data/json/map/map.json");
+    in >> json;
+    auto make_grid_json = [&json](int size) {
+        nlohmann::json grid_json;
+        for (int row = 0; row < size; ++row) {
+            for (int column = 0; column < size; ++column) {
+                auto cell = json["m_map"][0][0];
+                cell["m_territory_name"] = std::to_string(row * size + column);
+                grid_json[row][column] = cell;
+            }
+        }
+        return grid_json;
+    };
+    ::runebound::map::MapGrid grid;
+    CHECK_NOTHROW(::runebound::map::from_json(make_grid_json(15), grid));
+    CHECK(grid.get_cell(runebound::Point(14, 14)).get_territory_name() == "224");
+    CHECK_THROWS_AS(
+        ::runebound::map::from_json(make_grid_json(17), grid),
+        ::runebound::map::TooManyTerritoriesException
+    );
+}
+
+TEST_CASE("river index matches river list") {
+    ::runebound::map::Map map;
+    auto rivers = map.get_rivers();
+    int count_rivers = 0;
+    for (int row = 0; row < map.get_size(); ++row) {
+        for (int column = 0; column < map.get_size(); ++column) {
+            runebound::Point cell(row, column);
+            for (const auto &neighbour : map.get_neighbours(cell)) {
+                CHECK(
+                    map.check_river(cell, neighbour) ==
+                    (rivers.count({cell, neighbour}) > 0)
+                );
+                count_rivers += map.check_river(cell, neighbour);
+            }
+        }
+    }
+    CHECK(count_rivers == rivers.size());
+}
+
+TEST_CASE("map copies share cells until changed") {
+    const auto &standard = ::runebound::map::Map::get_standard();
+    ::runebound::map::Map map;
+    ::runebound::map::Map copy = map;
+    runebound::Point cell(0, 0);
+    copy.reverse_token(cell);
+    CHECK(
+        map.get_cell_map(cell).get_side_token() ==
+        standard.get_cell_map(cell).get_side_token()
+    );
+    CHECK(
+        copy.get_cell_map(cell).get_side_token() !=
+        map.get_cell_map(cell).get_side_token()
+    );
+    copy.reverse_token(cell);
+    CHECK(copy.to_json() == map.to_json());
+
+    auto json = map.to_json();
+    auto parsed = ::runebound::map::Map::from_json(json);
+    CHECK(parsed.to_json() == json);
+    CHECK(parsed.get_towns() == map.get_towns());
+    CHECK(&parsed.get_rivers() != &map.get_rivers());
+    CHECK(&copy.get_rivers() == &map.get_rivers());
+}
+
+TEST_CASE("neighbour tables match directions") {
+    using ::runebound::map::NO_NEIGHBOUR;
+    static_assert(
+        ::runebound::map::STANDARD_NEIGHBOUR_TABLE[0][0] == NO_NEIGHBOUR
+    );
+    static_assert(::runebound::map::STANDARD_NEIGHBOUR_TABLE[0][2] == 1);
+    for (int size : {::runebound::map::STANDARD_SIZE, 1, 4, 7}) {
+        auto table = ::runebound::map::get_neighbour_table(size);
+        REQUIRE(table.size() == static_cast<std::size_t>(size * size));
+        for (int row = 0; row < size; ++row) {
+            for (int column = 0; column < size; ++column) {
+                runebound::Point cell(row, column);
+                const auto &directions = ::runebound::map::get_directions(cell);
+                for (int direction = 0;
+                     direction < ::runebound::map::COUNT_DIRECTIONS;
+                     ++direction) {
+                    auto next = cell + directions[direction];
+                    bool inside = next.x >= 0 && next.x < size &&
+                                  next.y >= 0 && next.y < size;
+                    CHECK(
+                        table[row * size + column][direction] ==
+                        (inside ? next.x * size + next.y : NO_NEIGHBOUR)
+                    );
+                }
+            }
+        }
+    }
+    ::runebound::map::Map map;
+    CHECK(map.get_neighbours(runebound::Point(0, 0)).size() == 2);
+    CHECK(map.get_neighbours(runebound::Point(7, 7)).size() == 6);
+}
+
+TEST_CASE("terrain masks match the faces of the dice") {
+    using ::runebound::dice::HandDice;
+    using ::runebound::map::TypeCell;
+    const std::map<TypeCell, std::set<HandDice>> faces = {
+        {TypeCell::WATER, {HandDice::JOKER, HandDice::MOUNTAINS_WATER}},
+        {TypeCell::FOREST,
+         {HandDice::JOKER, HandDice::PLAIN_FOREST, HandDice::FOREST_HILLS}},
+        {TypeCell::MOUNTAINS, {HandDice::JOKER, HandDice::MOUNTAINS_WATER}},
+        {TypeCell::HILLS,
+         {HandDice::JOKER, HandDice::FOREST_HILLS, HandDice::HILLS_PLAIN}},
+        {TypeCell::PLAIN,
+         {HandDice::JOKER, HandDice::PLAIN, HandDice::PLAIN_FOREST,
+          HandDice::HILLS_PLAIN}},
+        {TypeCell::TOWN,
+         {HandDice::JOKER, HandDice::PLAIN, HandDice::PLAIN_FOREST,
+          HandDice::FOREST_HILLS, HandDice::MOUNTAINS_WATER,
+          HandDice::HILLS_PLAIN}}};
+    for (const auto &[type, allowed] : faces) {
+        for (int face = 0; face < ::runebound::dice::COUNT_FACES; ++face) {
+            auto dice = static_cast<HandDice>(face);
+            CHECK(
+                ::runebound::dice::check_hand_dice(type, dice) ==
+                allowed.contains(dice)
+            );
+        }
+    }
+}
+
+TEST_CASE("batched dice throws are uniform") {
+    using ::runebound::dice::HandDice;
+    const int count_throws = 60000;
+    ::runebound::Random random(7);
+    std::vector<HandDice> dice(count_throws);
+    ::runebound::dice::throw_dice(dice, random);
+    std::map<HandDice, int> counts;
+    for (auto face : dice) {
+        ++counts[face];
+    }
+    REQUIRE(counts.size() == ::runebound::dice::COUNT_FACES);
+    for (auto [face, count] : counts) {
+        CHECK(static_cast<int>(face) < ::runebound::dice::COUNT_FACES);
+        CHECK(count > 9500);
+        CHECK(count < 10500);
+    }
+    ::runebound::Random same(7);
+    CHECK(
+        ::runebound::dice::get_combination_of_dice(count_throws, same) == dice
+    );
+}
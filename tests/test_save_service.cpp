@@ -0,0 +1,35 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "doctest/doctest.h"
+#include "save_service.hpp"
+
+TEST_CASE("save service writes the last save") {
+    auto folder = std::filesystem::temp_directory_path() / "runebound_saves";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    {
+        ::runebound::network::SaveService service(folder);
+        for (int i = 0; i < 100; ++i) {
+            service.save("first", "{\"turn\": " + std::to_string(i) + "}");
+        }
+        service.save("second", "{}");
+        service.flush();
+        std::ifstream file(service.get_path("first"));
+        std::stringstream data;
+        data << file.rdbuf();
+        CHECK(data.str() == "{\"turn\": 99}");
+        service.save("second", "[]");
+    }
+    std::ifstream file(folder / "second.json");
+    std::stringstream data;
+    data << file.rdbuf();
+    CHECK(data.str() == "[]");
+    int count_files = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(folder)) {
+        CHECK(entry.path().extension() == ".json");
+        ++count_files;
+    }
+    CHECK(count_files == 2);
+    std::filesystem::remove_all(folder);
+}
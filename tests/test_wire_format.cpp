@@ -0,0 +1,61 @@
+#include <string>
+#include "doctest/doctest.h"
+#include "game.hpp"
+#include "game_client.hpp"
+#include "wire_format.hpp"
+
+TEST_CASE("wire formats keep messages") {
+    using runebound::network::WireFormat;
+    ::runebound::game::Game game;
+    nlohmann::json state = ::runebound::game::GameClient(game);
+    state["change type"] = "game";
+    nlohmann::json patch;
+    patch["change type"] = "game patch";
+    patch["patch"] = nlohmann::json::diff(state, nlohmann::json::object());
+
+    for (auto format : {WireFormat::JSON, WireFormat::CBOR, WireFormat::MSGPACK,
+                        WireFormat::PACKED}) {
+        CHECK(
+            runebound::network::wire_format_from_string(
+                runebound::network::to_string(format)
+            ) == format
+        );
+        auto bytes = runebound::network::encode_message(state, format) +
+                     runebound::network::encode_message(patch, format);
+        auto first = runebound::network::get_frame_size(bytes, format);
+        REQUIRE(first != 0);
+        CHECK(
+            runebound::network::get_frame_size(
+                std::string_view(bytes).substr(0, first - 1), format
+            ) == 0
+        );
+        CHECK(
+            runebound::network::decode_message(
+                std::string_view(bytes).substr(0, first), format
+            ) == state
+        );
+        auto rest = std::string_view(bytes).substr(first);
+        auto second = runebound::network::get_frame_size(rest, format);
+        REQUIRE(second == rest.size());
+        CHECK(runebound::network::decode_message(rest, format) == patch);
+    }
+
+    auto json_size =
+        runebound::network::encode_message(state, WireFormat::JSON).size();
+    auto packed_size =
+        runebound::network::encode_message(state, WireFormat::PACKED).size();
+    CHECK(packed_size * 3 < json_size);
+
+    runebound::network::OutgoingMessage message(patch);
+    CHECK(
+        &message.get_frame(WireFormat::CBOR) ==
+        &message.get_frame(WireFormat::CBOR)
+    );
+    CHECK(
+        message.get_frame(WireFormat::JSON) ==
+        runebound::network::encode_message(patch, WireFormat::JSON)
+    );
+    CHECK_THROWS(static_cast<void>(
+        runebound::network::wire_format_from_string("xml")
+    ));
+}